@@ -0,0 +1,53 @@
+// sjtu::deque (block list, O(sqrt n)) against sjtu::sequence (treap of chunks, O(log n)) for growing n:
+// random-position inserts, random at() and a full iterator scan.
+// build: g++ -O2 -I.. crossover.cpp -o crossover
+#include <iostream>
+#include <cstdio>
+#include <ctime>
+
+#include "deque.hpp"
+#include "sequence.hpp"
+
+static const int OPS = 200000;
+static const int SIZES[] = {1000, 10000, 100000, 1000000, 10000000, 30000000};
+
+unsigned long long now = 1;
+unsigned rnd()
+{
+	now = now * 6364136223846793005ull + 1442695040888963407ull;
+	return now >> 33;
+}
+
+double seconds(clock_t start) { return 1.0 * (clock() - start) / CLOCKS_PER_SEC; }
+
+template <class Seq>
+void run(const char *name, int n, long long &checksum)
+{
+	Seq s;
+	for (int i = 0; i < n; ++i) s.push_back(i);
+	now = n;
+	clock_t start = clock();
+	for (int i = 0; i < OPS; ++i) s.insert(s.begin() + rnd() % (s.size() + 1), i);
+	double ins = seconds(start);
+	start = clock();
+	for (int i = 0; i < OPS; ++i) checksum += s[rnd() % s.size()];
+	double at = seconds(start);
+	start = clock();
+	for (typename Seq::iterator it = s.begin(); it != s.end(); ++it) checksum += *it;
+	double scan = seconds(start);
+	start = clock();
+	for (int i = 0; i < OPS; ++i) s.erase(s.begin() + rnd() % s.size());
+	double era = seconds(start);
+	printf("%-9s n = %-9d insert %8.4fs  at %8.4fs  scan %8.4fs  erase %8.4fs\n", name, n, ins, at, scan, era);
+}
+
+int main()
+{
+	long long a = 0, b = 0;
+	for (int n : SIZES) {
+		run<sjtu::deque<int>>("deque", n, a);
+		run<sjtu::sequence<int>>("sequence", n, b);
+	}
+	std::cout << (a == b ? "checksums agree" : "CHECKSUMS DIFFER") << std::endl;
+	return a != b;
+}
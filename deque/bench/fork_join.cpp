@@ -0,0 +1,136 @@
+// recursive fork-join (fib with a sequential cutoff): the work-stealing thread_pool against the same
+// pool built on per-worker sjtu::deques behind one global lock.
+// build: g++ -O2 -pthread -I.. fork_join.cpp -o fork_join
+#include <iostream>
+#include <cstdio>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "deque.hpp"
+#include "thread_pool.hpp"
+
+static const int N = 36, CUTOFF = 10;
+
+// every worker has its own sjtu::deque, but a single mutex guards all of them
+class locked_pool
+{
+public:
+	typedef std::atomic<size_t> counter;
+private:
+	struct Task
+	{
+		std::function<void()> fn;
+		counter *join;
+	};
+
+	size_t n;
+	sjtu::deque<Task *> *queues;
+	std::thread *threads;
+	std::mutex lock;
+	std::atomic<bool> stop;
+
+	static int &self()
+	{
+		static thread_local int index = -1;
+		return index;
+	}
+
+	static size_t &depth()
+	{
+		static thread_local size_t d = 0;
+		return d;
+	}
+
+	bool take(int w, Task *&task, bool steal = true)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (w >= 0 && !queues[w].empty()) return task = queues[w].back(), queues[w].pop_back(), true;
+		if (!steal) return false;
+		for (size_t i = 0; i < n; ++i)
+			if (!queues[i].empty()) return task = queues[i].front(), queues[i].pop_front(), true;
+		return false;
+	}
+
+	static void run(Task *task)
+	{
+		task->fn();
+		task->join->fetch_sub(1, std::memory_order_release);
+		delete task;
+	}
+
+public:
+	explicit locked_pool(size_t threads_) : n(threads_), queues(new sjtu::deque<Task *>[threads_]), threads(new std::thread[threads_]), stop(false)
+	{
+		for (size_t i = 0; i < n; ++i)
+			threads[i] = std::thread([this, i] {
+				self() = i;
+				for (Task *task; !stop.load();)
+					if (take(i, task)) run(task);
+					else std::this_thread::yield();
+			});
+	}
+	~locked_pool()
+	{
+		stop = true;
+		for (size_t i = 0; i < n; ++i) threads[i].join();
+		delete[] threads, delete[] queues;
+	}
+	template <class Function>
+	void spawn(counter &join, Function &&fn)
+	{
+		join.fetch_add(1, std::memory_order_relaxed);
+		Task *task = new Task{std::function<void()>(std::forward<Function>(fn)), &join};
+		std::lock_guard<std::mutex> guard(lock);
+		queues[self() >= 0 ? self() : 0].push_back(task);
+	}
+	// same helping rule as thread_pool::wait
+	void wait(counter &join)
+	{
+		size_t &d = depth();
+		++d;
+		for (Task *task; join.load(std::memory_order_acquire);)
+			if (self() >= 0 && take(self(), task, d < sjtu::thread_pool::max_depth)) run(task);
+			else std::this_thread::yield();
+		--d;
+	}
+};
+
+long long fib_seq(int n) { return n < 2 ? n : fib_seq(n - 1) + fib_seq(n - 2); }
+
+template <class Pool>
+long long fib(Pool &pool, int n)
+{
+	if (n < CUTOFF) return fib_seq(n);
+	long long a, b;
+	typename Pool::counter join(0);
+	pool.spawn(join, [&pool, &a, n] { a = fib(pool, n - 1); });
+	b = fib(pool, n - 2);
+	pool.wait(join);
+	return a + b;
+}
+
+template <class Pool>
+long long run(const char *name, size_t threads)
+{
+	Pool pool(threads);
+	auto start = std::chrono::steady_clock::now();
+	long long ret = fib(pool, N);
+	double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%-14s %2d threads: fib(%d) = %lld in %.3fs\n", name, (int)threads, N, ret, t);
+	return ret;
+}
+
+int main()
+{
+	size_t hw = std::thread::hardware_concurrency();
+	if (!hw) hw = 1;
+	bool ok = true;
+	for (size_t threads = 1; threads <= hw * 2 || threads <= 4; threads <<= 1) {
+		long long a = run<sjtu::thread_pool>("work stealing", threads);
+		long long b = run<locked_pool>("locked deque", threads);
+		ok &= a == b;
+	}
+	std::cout << (ok ? "results agree" : "RESULTS DIFFER") << std::endl;
+	return !ok;
+}
@@ -0,0 +1,138 @@
+// pipeline queues: spsc_queue and mpmc_queue against a mutex-protected sjtu::deque doing push_back and
+// pop_front. throughput moves ITEMS ints from producers to consumers (one at a time and in batches);
+// latency bounces one int between two threads through a pair of queues.
+// build: g++ -O2 -pthread -I.. ring_queue.cpp -o ring_queue
+#include <iostream>
+#include <cstdio>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "deque.hpp"
+#include "ring_queue.hpp"
+
+static const size_t ITEMS = 4000000, BATCH = 64, PINGS = 20000, CAPACITY = 1024;
+
+// the baseline: an unbounded sjtu::deque behind a mutex, with the same interface
+template <class T>
+class locked_queue
+{
+	std::mutex lock;
+	sjtu::deque<T> q;
+
+public:
+	explicit locked_queue(size_t) {}
+	bool try_push(const T &value)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		return q.push_back(value), true;
+	}
+	size_t try_push(const T *first, size_t n)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		for (size_t i = 0; i < n; ++i) q.push_back(first[i]);
+		return n;
+	}
+	bool try_pop(T &out)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (q.empty()) return false;
+		return out = q.front(), q.pop_front(), true;
+	}
+	size_t try_pop(T *out, size_t n)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		size_t i = 0;
+		for (; i < n && !q.empty(); ++i) out[i] = q.front(), q.pop_front();
+		return i;
+	}
+	void push(const T &value) { try_push(value); }
+	void pop(T &out)
+	{
+		for (size_t round = 0; !try_pop(out);) sjtu::ring_detail::backoff(round);
+	}
+};
+
+double seconds(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// producers push 1..ITEMS split between them; consumers add up what they get
+template <class Queue>
+bool throughput(const char *name, int producers, int consumers, size_t batch)
+{
+	Queue q(CAPACITY);
+	std::vector<std::thread> threads;
+	std::vector<unsigned long long> sums(consumers);
+	std::atomic<size_t> left(ITEMS);
+	auto start = std::chrono::steady_clock::now();
+	for (int p = 0; p < producers; ++p)
+		threads.emplace_back([&q, p, producers, batch] {
+			std::vector<size_t> buf(batch);
+			for (size_t i = p + 1; i <= ITEMS;) {
+				size_t n = 0;
+				for (; n < batch && i <= ITEMS; ++n, i += producers) buf[n] = i;
+				for (size_t done = 0, round = 0; done < n;) {
+					size_t k = batch == 1 ? q.try_push(buf[0]) : q.try_push(buf.data() + done, n - done);
+					if (k) done += k, round = 0;
+					else sjtu::ring_detail::backoff(round);
+				}
+			}
+		});
+	for (int c = 0; c < consumers; ++c)
+		threads.emplace_back([&q, &sums, &left, c, batch] {
+			std::vector<size_t> buf(batch);
+			unsigned long long sum = 0;
+			for (size_t round = 0; left.load(std::memory_order_relaxed);) {
+				size_t k = batch == 1 ? q.try_pop(buf[0]) : q.try_pop(buf.data(), batch);
+				if (!k) {
+					sjtu::ring_detail::backoff(round);
+					continue;
+				}
+				round = 0, left -= k;
+				for (size_t i = 0; i < k; ++i) sum += buf[i];
+			}
+			sums[c] = sum;
+		});
+	for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+	double t = seconds(start);
+	unsigned long long sum = 0;
+	for (int c = 0; c < consumers; ++c) sum += sums[c];
+	printf("%-14s %dP%dC batch %-3d %7.2f Mitems/s\n", name, producers, consumers, (int)batch, ITEMS / t / 1e6);
+	return sum == (unsigned long long)ITEMS * (ITEMS + 1) / 2;
+}
+
+// average round trip of one item through two queues
+template <class Queue>
+void latency(const char *name)
+{
+	Queue there(CAPACITY), back(CAPACITY);
+	std::thread echo([&there, &back] {
+		for (size_t i = 0, v; i < PINGS; ++i) there.pop(v), back.push(v);
+	});
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0, v; i < PINGS; ++i) there.push(i), back.pop(v);
+	double t = seconds(start);
+	echo.join();
+	printf("%-14s round trip %8.0f ns\n", name, t / PINGS * 1e9);
+}
+
+int main()
+{
+	bool ok = true;
+	ok &= throughput<sjtu::spsc_queue<size_t>>("spsc_queue", 1, 1, 1);
+	ok &= throughput<locked_queue<size_t>>("locked deque", 1, 1, 1);
+	ok &= throughput<sjtu::spsc_queue<size_t>>("spsc_queue", 1, 1, BATCH);
+	ok &= throughput<locked_queue<size_t>>("locked deque", 1, 1, BATCH);
+	ok &= throughput<sjtu::mpmc_queue<size_t>>("mpmc_queue", 2, 2, 1);
+	ok &= throughput<locked_queue<size_t>>("locked deque", 2, 2, 1);
+	ok &= throughput<sjtu::mpmc_queue<size_t>>("mpmc_queue", 2, 2, BATCH);
+	ok &= throughput<locked_queue<size_t>>("locked deque", 2, 2, BATCH);
+	latency<sjtu::spsc_queue<size_t>>("spsc_queue");
+	latency<sjtu::mpmc_queue<size_t>>("mpmc_queue");
+	latency<locked_queue<size_t>>("locked deque");
+	std::cout << (ok ? "sums agree" : "SUMS DIFFER") << std::endl;
+	return !ok;
+}
@@ -0,0 +1,81 @@
+// scanning N ints: std::vector, std::deque and sjtu::deque through operator[], through iterator ++ and
+// through for_each_segment, serially and on a thread_pool.
+// build: g++ -O2 -pthread -I.. segments.cpp -o segments
+#include <iostream>
+#include <cstdio>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+#include "deque.hpp"
+#include "thread_pool.hpp"
+
+static const int N = 10000000, ROUNDS = 5;
+
+template <class Scan>
+long long measure(const char *name, Scan scan)
+{
+	long long sum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < ROUNDS; ++r) sum += scan();
+	double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+	printf("%-34s %7.2f ms %6.2f ns/element\n", name, t * 1e3, t / N * 1e9);
+	return sum;
+}
+
+int main()
+{
+	std::vector<int> v;
+	std::deque<int> stl;
+	sjtu::deque<int> q;
+	// a mix of pushes at both ends, so the blocks are not all aligned the same way
+	for (int i = 0; i < N; ++i) {
+		int x = i * 7 % 1000;
+		v.push_back(x), stl.push_back(x);
+		if (i & 1) q.push_back(x);
+		else q.push_front(x);
+	}
+	sjtu::thread_pool pool;
+	std::vector<long long> sums;
+	sums.push_back(measure("std::vector index", [&] {
+		long long s = 0;
+		for (size_t i = 0; i < v.size(); ++i) s += v[i];
+		return s;
+	}));
+	sums.push_back(measure("std::deque iterator", [&] {
+		long long s = 0;
+		for (std::deque<int>::iterator it = stl.begin(); it != stl.end(); ++it) s += *it;
+		return s;
+	}));
+	sums.push_back(measure("sjtu::deque operator[]", [&] {
+		long long s = 0;
+		for (size_t i = 0; i < q.size(); ++i) s += q[i];
+		return s;
+	}));
+	sums.push_back(measure("sjtu::deque iterator ++", [&] {
+		long long s = 0;
+		for (sjtu::deque<int>::iterator it = q.begin(); it != q.end(); ++it) s += *it;
+		return s;
+	}));
+	sums.push_back(measure("sjtu::deque for_each_segment", [&] {
+		long long s = 0;
+		q.for_each_segment([&s](const int *first, const int *last) {
+			for (; first != last; ++first) s += *first;
+		});
+		return s;
+	}));
+	sums.push_back(measure("thread_pool for_each_segment", [&] {
+		std::atomic<long long> s(0);
+		pool.for_each_segment(q, [&s](int *first, int *last) {
+			long long part = 0;
+			for (; first != last; ++first) part += *first;
+			s += part;
+		});
+		return s.load();
+	}));
+	bool ok = true;
+	for (size_t i = 0; i < sums.size(); ++i) ok &= sums[i] == sums[0];
+	printf("%u threads in the pool\n", (unsigned)pool.size());
+	std::cout << (ok ? "sums agree" : "SUMS DIFFER") << std::endl;
+	return !ok;
+}
@@ -0,0 +1,43 @@
+#include <iostream>
+#include <cstdio>
+#include "deque.hpp"
+#include "exceptions.hpp"
+
+//iterators carry their index: distances are subtractions, and an iterator kept across
+//modifications still refers to the same index once its cached block is out of date
+int main(){
+	sjtu::deque<int> q;
+	for(int i = 0; i < 100000; i++) q.push_back(i);
+	sjtu::deque<int>::iterator it = q.begin() + 5000, last = q.end() - 1;
+	sjtu::deque<int>::const_iterator cit = it;
+	printf("%d %d %d %d\n", *it, *last, (int)(q.end() - it), (int)(last - q.begin()));
+	for(int i = 1; i <= 30000; i++) q.push_front(-i);
+	printf("%d %d %d\n", *it, *cit, *last);
+	for(int i = 0; i < 20000; i++) q.erase(q.begin() + 40000);
+	printf("%d %d %d\n", *it, *(it + 60000), *(it - 5000));
+	it = q.begin() + 70000;
+	for(int i = 0; i < 50000; i++) q.pop_back();
+	try{
+		*it;
+		puts("no throw");
+	} catch(sjtu::invalid_iterator){
+		puts("stale past-the-end iterator throws");
+	}
+	try{
+		it = q.end() + 1;
+		puts("no throw");
+	} catch(sjtu::invalid_iterator){
+		puts("end() + 1 throws");
+	}
+	long long sum = 0;
+	int cnt = 0;
+	for(sjtu::deque<int>::const_iterator i = q.cbegin(); i != q.cend(); ++i, ++cnt) sum += *i;
+	printf("%d %lld %d\n", cnt, sum, (int)(q.cend() - q.cbegin()));
+	sjtu::deque<int> other(q);
+	try{
+		printf("%d\n", other.end() - q.begin());
+	} catch(sjtu::invalid_iterator){
+		puts("distance across deques throws");
+	}
+	return 0;
+}
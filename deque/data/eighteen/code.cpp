@@ -0,0 +1,111 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include <thread>
+#include "deque.hpp"
+
+//snapshots share blocks with the deque they were taken from: both must keep their own contents
+//through later changes on either side, and every element must still be destroyed exactly once
+class Counted {
+public:
+	static int alive, copies;
+	int v;
+
+	Counted(int v = 0) : v(v) {alive++;}
+	Counted(const Counted &rhs) : v(rhs.v) {alive++, copies++;}
+	Counted &operator=(const Counted &rhs) {v = rhs.v; return *this;}
+	~Counted() {alive--;}
+};
+
+int Counted::alive = 0, Counted::copies = 0;
+
+unsigned seed = 1000000007;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+template <class Q>
+bool same(const Q &q, const std::deque<int> &stl){
+	if(q.size() != stl.size()) return 0;
+	size_t i = 0;
+	for(typename Q::const_iterator it = q.cbegin(); it != q.cend(); ++it, ++i)
+		if(it->v != stl[i]) return 0;
+	return 1;
+}
+
+void mutate(sjtu::deque<Counted> &q, std::deque<int> &stl){
+	int op = rnd() % 7, v = rnd() % 1000;
+	if(op == 0) q.push_back(Counted(v)), stl.push_back(v);
+	else if(op == 1) q.push_front(Counted(v)), stl.push_front(v);
+	else if(op == 2){
+		size_t k = rnd() % (stl.size() + 1);
+		q.insert(q.begin() + k, Counted(v)), stl.insert(stl.begin() + k, v);
+	}
+	else if(stl.empty()) return;
+	else if(op == 3){
+		size_t k = rnd() % stl.size();
+		q.erase(q.begin() + k), stl.erase(stl.begin() + k);
+	}
+	else if(op == 4) q.pop_back(), stl.pop_back();
+	else if(op == 5){
+		size_t k = rnd() % stl.size();
+		q[k].v = v, stl[k] = v;
+	}
+	else{
+		size_t k = rnd() % stl.size();
+		(q.begin() + k)->v = v, stl[k] = v;
+	}
+}
+
+int main(){
+	bool ok = 1;
+	{
+		sjtu::deque<Counted> q;
+		std::deque<int> stl;
+		for(int i = 0; i < 100000; i++) q.push_back(Counted(i)), stl.push_back(i);
+		int before = Counted::copies;
+		sjtu::deque<Counted> snap = q.snapshot();
+		if(Counted::copies != before || Counted::alive != 100000) ok = 0;//nothing copied yet
+		std::deque<int> saved = stl;
+		q[50000].v = -1, stl[50000] = -1;
+		if(Counted::copies - before > 2000 || snap[50000].v != 50000) ok = 0;//one block cloned
+		for(int round = 0; round < 20; round++){
+			for(int i = 0; i < 2000; i++) mutate(q, stl);
+			if(round % 4 == 0){
+				snap = q.snapshot(), saved = stl;
+				sjtu::deque<Counted> again = snap.snapshot();
+				for(int i = 0; i < 300; i++) mutate(again, saved);
+				if(!same(again, saved)) ok = 0;
+				saved = stl;
+			}
+			if(!same(q, stl) || !same(snap, saved)) ok = 0;
+			for(int i = 0; i < 500; i++) mutate(snap, saved);
+			if(!same(q, stl) || !same(snap, saved)) ok = 0;
+		}
+		q.clear(), stl.clear();
+		if(!same(snap, saved) || Counted::alive != (int)saved.size()) ok = 0;
+	}
+	if(Counted::alive) ok = 0;
+	puts(ok ? "snapshots ok" : "snapshots wrong");
+
+	//a background thread sums a snapshot while the deque keeps changing
+	sjtu::deque<int> q;
+	long long expect = 0;
+	for(int i = 0; i < 1000000; i++) q.push_back(i), expect += i;
+	for(int round = 0; round < 5; round++){
+		const sjtu::deque<int> *snap = new sjtu::deque<int>(q.snapshot());
+		long long sum = 0;
+		std::thread reader([&sum, snap]{
+			snap->for_each_segment([&sum](const int *first, const int *last){for(; first != last; ++first) sum += *first;});
+			delete snap;
+		});
+		for(int i = 0; i < 20000; i++) q[rnd() % q.size()] += 1, q.push_back(0), q.pop_front();
+		reader.join();
+		if(sum != expect) ok = 0;
+		expect = 0;
+		for(size_t i = 0; i < q.size(); i++) expect += const_cast<const sjtu::deque<int> &>(q)[i];
+	}
+	puts(ok ? "threads ok" : "threads wrong");
+	return 0;
+}
@@ -0,0 +1,80 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include "deque.hpp"
+#include "exceptions.hpp"
+
+//split_at, append and splice hand whole blocks over, so moving large slices relocates only boundary elements
+unsigned seed = 998244353;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+template <class D>
+bool same(D &q, const std::deque<int> &stl){
+	if(q.size() != stl.size()) return 0;
+	int i = 0;
+	for(typename D::iterator it = q.begin(); it != q.end(); ++it, ++i)
+		if(*it != stl[i]) return 0;
+	for(i = 0; i < (int)stl.size(); i += 97)
+		if(q[i] != stl[i]) return 0;
+	return 1;
+}
+
+int main(){
+	sjtu::deque<int> a, b;
+	std::deque<int> sa, sb;
+	for(int i = 0; i < 200000; i++) a.push_back(i), sa.push_back(i);
+	for(int i = 0; i < 100000; i++) b.push_front(-i), sb.push_front(-i);
+
+	size_t moved = sjtu::deque<int>::relocation_count();
+	sjtu::deque<int> c = a.split_at(123457);
+	std::deque<int> sc(sa.begin() + 123457, sa.end());
+	sa.erase(sa.begin() + 123457, sa.end());
+	printf("split: %s %s %d %d\n", same(a, sa) ? "ok" : "wrong", same(c, sc) ? "ok" : "wrong", (int)a.size(), (int)c.size());
+
+	a.splice(a.begin() + 5000, b);
+	sa.insert(sa.begin() + 5000, sb.begin(), sb.end()), sb.clear();
+	printf("splice: %s %s %d\n", same(a, sa) ? "ok" : "wrong", b.empty() ? "empty" : "not empty", (int)a.size());
+
+	a.append(std::move(c));
+	sa.insert(sa.end(), sc.begin(), sc.end()), sc.clear();
+	printf("append: %s %s %d\n", same(a, sa) ? "ok" : "wrong", c.empty() ? "empty" : "not empty", (int)a.size());
+	printf("relocations bounded: %s\n", sjtu::deque<int>::relocation_count() - moved < 20000 ? "yes" : "no");
+
+	//random slicing keeps everything consistent
+	for(int round = 0; round < 200; round++){
+		size_t k = rnd() % (sa.size() + 1);
+		sjtu::deque<int> t = a.split_at(k);
+		std::deque<int> st(sa.begin() + k, sa.end());
+		sa.erase(sa.begin() + k, sa.end());
+		if(rnd() % 2){
+			b.append(std::move(t)), sb.insert(sb.end(), st.begin(), st.end());
+		} else {
+			size_t p = rnd() % (sb.size() + 1);
+			b.splice(b.begin() + p, t), sb.insert(sb.begin() + p, st.begin(), st.end());
+		}
+		if(rnd() % 3 == 0){
+			size_t p = rnd() % (sa.size() + 1);
+			a.splice(a.begin() + p, b), sa.insert(sa.begin() + p, sb.begin(), sb.end()), sb.clear();
+		}
+		if(rnd() % 4 == 0) a.push_front(-round), sa.push_front(-round), b.push_back(round), sb.push_back(round);
+		if(!same(a, sa) || !same(b, sb)){
+			printf("round %d wrong\n", round);
+			return 0;
+		}
+	}
+	printf("random slicing: ok %d %d\n", (int)a.size(), (int)b.size());
+	sjtu::deque<int> e = a.split_at(0);
+	printf("split at 0: %d %d\n", (int)a.size(), (int)e.size());
+	e.append(std::move(a));
+	a.push_back(1), e.splice(e.end(), a);
+	printf("%d %d %d\n", (int)e.size(), e.back(), (int)a.size());
+	try{
+		e.split_at(e.size() + 1);
+	} catch(sjtu::index_out_of_bound){
+		puts("split past the end throws");
+	}
+	return 0;
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <cstdio>
+#include <atomic>
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ring_queue.hpp"
+
+//spsc_queue and mpmc_queue from one thread against std::deque, then across threads
+unsigned seed = 1000000007;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+template <class Q>
+bool single(){
+	Q q(100);
+	std::deque<std::string> stl;
+	std::string buf[40];
+	if(q.capacity() != 128) return 0;
+	for(int i = 0; i < 100000; i++){
+		int op = rnd() % 4;
+		if(op == 0){
+			std::string v = std::to_string(rnd());
+			if(q.try_push(v) != (stl.size() < 128)) return 0;
+			if(stl.size() < 128) stl.push_back(v);
+		}
+		else if(op == 1){
+			int n = rnd() % 40;
+			for(int j = 0; j < n; j++) buf[j] = std::to_string(rnd());
+			size_t k = q.try_push(buf, n);
+			if(k != std::min((size_t)n, 128 - stl.size())) return 0;
+			for(size_t j = 0; j < k; j++) stl.push_back(buf[j]);
+		}
+		else if(op == 2){
+			std::string v;
+			if(q.try_pop(v) != !stl.empty()) return 0;
+			if(!stl.empty()){
+				if(v != stl.front()) return 0;
+				stl.pop_front();
+			}
+		}
+		else{
+			size_t n = rnd() % 40, k = q.try_pop(buf, n);
+			if(k != std::min(n, stl.size())) return 0;
+			for(size_t j = 0; j < k; j++, stl.pop_front())
+				if(buf[j] != stl.front()) return 0;
+		}
+		if(q.size() != stl.size() || q.empty() != stl.empty()) return 0;
+	}
+	return 1;//what is left is destroyed with q
+}
+
+template <class Q>
+bool threaded(int producers, int consumers){
+	const int items = 200000;
+	Q q(64);
+	std::vector<std::thread> threads;
+	std::vector<long long> sums(consumers);
+	std::vector<int> last(consumers * producers, 0);
+	std::atomic<bool> ordered(1);
+	std::atomic<int> left(items);
+	for(int p = 0; p < producers; p++)
+		threads.emplace_back([&q, p, producers]{
+			for(int i = p + 1; i <= items; i += producers) q.push(i);
+		});
+	for(int c = 0; c < consumers; c++)
+		threads.emplace_back([&, c]{
+			long long sum = 0;
+			for(int v; left.fetch_sub(1) > 0;){
+				q.pop(v), sum += v;
+				//each producer's items reach one consumer in the order they were pushed
+				int &l = last[c * producers + (v - 1) % producers];
+				if(v <= l) ordered = 0;
+				l = v;
+			}
+			sums[c] = sum;
+		});
+	for(size_t i = 0; i < threads.size(); i++) threads[i].join();
+	long long sum = 0;
+	for(int c = 0; c < consumers; c++) sum += sums[c];
+	return ordered && sum == (long long)items * (items + 1) / 2 && q.empty();
+}
+
+int main(){
+	puts(single<sjtu::spsc_queue<std::string>>() ? "spsc ok" : "spsc wrong");
+	puts(single<sjtu::mpmc_queue<std::string>>() ? "mpmc ok" : "mpmc wrong");
+	puts(threaded<sjtu::spsc_queue<int>>(1, 1) ? "spsc threads ok" : "spsc threads wrong");
+	puts(threaded<sjtu::mpmc_queue<int>>(3, 2) ? "mpmc threads ok" : "mpmc threads wrong");
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include <vector>
+#include "work_stealing_deque.hpp"
+#include "thread_pool.hpp"
+
+//work_stealing_deque from one thread against std::deque, then a fork-join sum on thread_pool
+unsigned seed = 1000000007;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+long long sum(sjtu::thread_pool &pool, const std::vector<int> &v, size_t l, size_t r){
+	if(r - l <= 1000){
+		long long s = 0;
+		for(size_t i = l; i < r; i++) s += v[i];
+		return s;
+	}
+	size_t m = (l + r) / 2;
+	long long a, b;
+	sjtu::thread_pool::counter join(0);
+	pool.spawn(join, [&pool, &v, &a, l, m] { a = sum(pool, v, l, m); });
+	b = sum(pool, v, m, r);
+	pool.wait(join);
+	return a + b;
+}
+
+int main(){
+	sjtu::work_stealing_deque<int> q(4);
+	std::deque<int> stl;
+	bool ok = 1;
+	for(int i = 0; i < 200000; i++){
+		int op = rnd() % 3, v = rnd(), x;
+		if(op == 0 || stl.empty()) q.push(v), stl.push_back(v);
+		else if(op == 1){
+			if(!q.pop(x) || x != stl.back()) ok = 0;
+			stl.pop_back();
+		}
+		else{
+			if(!q.steal(x) || x != stl.front()) ok = 0;
+			stl.pop_front();
+		}
+		if(q.size() != stl.size()) ok = 0;
+	}
+	int x;
+	for(; !stl.empty(); stl.pop_back()) if(!q.pop(x) || x != stl.back()) ok = 0;
+	if(q.pop(x) || q.steal(x) || !q.empty()) ok = 0;
+	puts(ok ? "deque ok" : "deque wrong");
+
+	std::vector<int> v(1000000);
+	long long expect = 0;
+	for(size_t i = 0; i < v.size(); i++) v[i] = rnd() % 1000, expect += v[i];
+	for(int threads = 1; threads <= 4; threads <<= 1){
+		sjtu::thread_pool pool(threads);
+		for(int round = 0; round < 5; round++)
+			if(sum(pool, v, 0, v.size()) != expect) ok = 0;
+	}
+	puts(ok ? "pool ok" : "pool wrong");
+	return 0;
+}
@@ -0,0 +1,58 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include "deque.hpp"
+#include "exceptions.hpp"
+
+//erase-heavy load: blocks that run underfull are merged and block sizes shrink with the deque,
+//so the contents must keep matching std::deque through drains and refills
+unsigned seed = 20260101;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+sjtu::deque<long long> q;
+std::deque<long long> stl;
+
+bool equal(){
+	if(q.size() != stl.size()) return 0;
+	for(size_t i = 0; i < stl.size(); i++)
+		if(q[i] != stl[i]) return 0;
+	sjtu::deque<long long>::iterator it = q.begin();
+	for(size_t i = 0; i < stl.size(); i++, ++it)
+		if(*it != stl[i]) return 0;
+	return it == q.end();
+}
+
+int main(){
+	for(int round = 0; round < 3; round++){
+		for(int i = 0; i < 30000; i++){
+			long long v = rnd();
+			if(rnd() % 2) q.push_back(v), stl.push_back(v);
+			else{
+				size_t k = rnd() % (stl.size() + 1);
+				q.insert(q.begin() + k, v), stl.insert(stl.begin() + k, v);
+			}
+		}
+		printf("round %d filled: %s\n", round, equal() ? "ok" : "wrong");
+		while(stl.size() > 100){
+			size_t k = rnd() % stl.size();
+			q.erase(q.begin() + k), stl.erase(stl.begin() + k);
+		}
+		printf("round %d erased: %s\n", round, equal() ? "ok" : "wrong");
+		for(int i = 0; i < 50; i++) q.pop_front(), stl.pop_front(), q.pop_back(), stl.pop_back();
+		printf("round %d drained: %s %d\n", round, equal() ? "ok" : "wrong", (int)q.size());
+		for(int i = 0; i < 1000; i++){
+			long long v = rnd();
+			if(i % 3 == 0) q.push_front(v), stl.push_front(v);
+			else q.push_back(v), stl.push_back(v);
+			if(i % 7 == 6){
+				size_t k = rnd() % stl.size();
+				q.erase(q.begin() + k), stl.erase(stl.begin() + k);
+			}
+		}
+		printf("round %d refilled: %s\n", round, equal() ? "ok" : "wrong");
+	}
+	return 0;
+}
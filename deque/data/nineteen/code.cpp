@@ -0,0 +1,73 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include "deque.hpp"
+
+//move construction and assignment hand over the blocks without touching an element; emplace builds
+//in place, and a move-only type survives pushes, inserts, splits and merges
+struct Counted{
+	static int copies, moves;
+	int v;
+	std::string s;
+	Counted(int v_, const std::string &s_) : v(v_), s(s_) {}
+	Counted(const Counted &o) : v(o.v), s(o.s) {++copies;}
+	Counted(Counted &&o) : v(o.v), s(std::move(o.s)) {++moves;}
+};
+int Counted::copies = 0, Counted::moves = 0;
+
+int main(){
+	bool ok = 1;
+	sjtu::deque<Counted> a;
+	for(int i = 0; i < 100000; i++){
+		if(i & 1) a.emplace_back(i, "x");
+		else a.emplace_front(i, "y");
+	}
+	if(Counted::copies) ok = 0, puts("emplace copied");
+	int moves = Counted::moves;
+	sjtu::deque<Counted> b(std::move(a));
+	if(Counted::moves != moves || Counted::copies) ok = 0, puts("move construction touched elements");
+	if(a.size() != 0 || b.size() != 100000 || b.front().v != 99998 || b.back().v != 99999) ok = 0;
+	sjtu::deque<Counted> c;
+	c.emplace_back(-1, "z");
+	c = std::move(b);
+	if(Counted::moves != moves || Counted::copies) ok = 0, puts("move assignment touched elements");
+	if(b.size() != 0 || c.size() != 100000 || c[50000].v != 1 || c[49999].v != 0) ok = 0;
+	b.push_back(Counted(7, "w")), a = c;
+	if(b.size() != 1 || b[0].v != 7 || a.size() != 100000 || Counted::copies != 100000) ok = 0;
+	sjtu::deque<Counted>::iterator it = c.emplace(c.begin() + 3, 5, "m");
+	if(it -> v != 5 || c[3].v != 5 || c.size() != 100001) ok = 0;
+	c.insert(c.end(), Counted(6, "e"));
+	if(Counted::copies != 100000 || c.back().v != 6) ok = 0;
+
+	sjtu::deque<std::unique_ptr<int>> q;
+	std::deque<int> stl;
+	unsigned seed = 1000000007;
+	for(int i = 0; i < 30000; i++){
+		seed = seed * 1103515245 + 12345;
+		int r = seed >> 8, op = r % 6, v = r % 1000;
+		if(op == 0) q.push_back(std::unique_ptr<int>(new int(v))), stl.push_back(v);
+		else if(op == 1) q.push_front(std::unique_ptr<int>(new int(v))), stl.push_front(v);
+		else if(op == 2){
+			size_t k = r % (stl.size() + 1);
+			q.emplace(q.begin() + k, new int(v)), stl.insert(stl.begin() + k, v);
+		}
+		else if(op == 3 && !stl.empty()){
+			size_t k = r % stl.size();
+			q.erase(q.begin() + k), stl.erase(stl.begin() + k);
+		}
+		else if(op == 4 && i % 300 == 0){
+			sjtu::deque<std::unique_ptr<int>> tail = q.split_at(r % (stl.size() + 1));
+			q.append(std::move(tail));
+		}
+		else if(op == 5 && i % 1000 == 0){
+			sjtu::deque<std::unique_ptr<int>> tmp(std::move(q));
+			q = std::move(tmp);
+		}
+	}
+	if(q.size() != stl.size()) ok = 0;
+	else for(size_t i = 0; i < stl.size(); i++) if(*q[i] != stl[i]) ok = 0;
+	puts(ok ? "ok" : "wrong");
+	return 0;
+}
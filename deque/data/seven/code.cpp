@@ -0,0 +1,46 @@
+#include <iostream>
+#include <cstdio>
+#include <thread>
+#include "deque.hpp"
+#include "exceptions.hpp"
+
+//counts every copy of T, so growing the deque can be checked to copy nothing but what the deque relocates
+long long copies = 0;
+
+class T{
+private:
+	int x;
+public:
+	T(int x):x(x){}
+	T(const T &other):x(other.x){++copies;}
+	int num()const {return x;}
+};
+
+//middle inserts into a deque of its own; the same work every time, so the same number of relocations
+void churn(){
+	sjtu::deque<int> q;
+	for(int i = 0; i < 20000; i++) q.insert(q.begin() + (int)(q.size() / 2), i);
+}
+
+int main(){
+	const int N = 200000;
+	sjtu::deque<T> q;
+	long long asked = 0;
+	for(int i = 0; i < N; i++, asked++) q.push_back(T(i));
+	for(int i = 0; i < N; i++, asked++) q.push_front(T(-i));
+	for(int i = 0; i < 2000; i++, asked++) q.insert(q.begin() + (int)(q.size() / 2), T(i));
+	printf("size %d\n", (int)q.size());
+	printf("only relocations copy: %s\n", copies == asked + (long long)sjtu::deque<T>::relocation_count() ? "yes" : "no");
+	long long sum = 0;
+	for(int i = 0; i < (int)q.size(); i += 1000) sum += q[i].num();
+	printf("front %d back %d sum %lld\n", q.front().num(), q.back().num(), sum);
+	for(int i = 0; i < N; i++) q.pop_back(), q.pop_front();
+	printf("size %d\n", (int)q.size());
+	size_t before = sjtu::deque<int>::relocation_count();
+	churn();
+	size_t one = sjtu::deque<int>::relocation_count() - before;
+	std::thread a(churn), b(churn);
+	a.join(), b.join();
+	printf("relocations counted across threads: %s\n", sjtu::deque<int>::relocation_count() - before == 3 * one ? "yes" : "no");
+	return 0;
+}
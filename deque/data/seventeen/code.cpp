@@ -0,0 +1,49 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include "deque.hpp"
+
+//runs of nearby at() between modifications, against std::deque; the finger at() keeps must follow
+//every change of the block structure
+unsigned seed = 1000000007;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+int main(){
+	sjtu::deque<int> q;
+	std::deque<int> stl;
+	bool ok = 1;
+	for(int i = 0; i < 50000; i++){
+		int op = rnd() % 6, v = rnd() % 1000000;
+		if(op == 0) q.push_back(v), stl.push_back(v);
+		else if(op == 1) q.push_front(v), stl.push_front(v);
+		else if(op == 2){
+			size_t k = rnd() % (stl.size() + 1);
+			q.insert(q.begin() + k, v), stl.insert(stl.begin() + k, v);
+		}
+		else if(op == 3 && !stl.empty()){
+			size_t k = rnd() % stl.size();
+			q.erase(q.begin() + k), stl.erase(stl.begin() + k);
+		}
+		else if(op == 4 && i % 500 == 0){
+			size_t k = rnd() % (stl.size() + 1);
+			sjtu::deque<int> tail = q.split_at(k);
+			q.append(std::move(tail));
+		}
+		if(stl.empty()) continue;
+		long long p = rnd() % stl.size();
+		int steps = rnd() % 40, width = rnd() % 2 ? 3 : 3000;
+		for(int j = 0; j < steps; j++){
+			p += (long long)(rnd() % (2 * width + 1)) - width;
+			if(p < 0) p = 0;
+			if(p >= (long long)stl.size()) p = stl.size() - 1;
+			if(q.at(p) != stl[p] || q[p] != stl[p]) ok = 0;
+		}
+	}
+	const sjtu::deque<int> &c = q;
+	for(size_t i = stl.size(); i --;) if(c[i] != stl[i]) ok = 0;
+	puts(ok ? "ok" : "wrong");
+	return 0;
+}
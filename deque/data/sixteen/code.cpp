@@ -0,0 +1,80 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include "deque.hpp"
+#include "thread_pool.hpp"
+#include "exceptions.hpp"
+
+//for_each_segment against std::deque after mixed operations, over the whole deque and over ranges
+unsigned seed = 1000000007;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+struct Collect{
+	std::deque<int> *out;
+	size_t *runs;
+	void operator()(const int *first, const int *last) const{
+		if(first >= last) ++*runs;//an empty run is never handed out
+		for(; first != last; ++first) out->push_back(*first);
+	}
+};
+
+int main(){
+	sjtu::deque<int> q;
+	std::deque<int> stl;
+	bool ok = 1;
+	for(int i = 0; i < 200000; i++){
+		int op = rnd() % 5, v = rnd() % 1000;
+		if(op == 0 || op == 1) q.push_back(v), stl.push_back(v);
+		else if(op == 2) q.push_front(v), stl.push_front(v);
+		else if(op == 3){
+			size_t k = rnd() % (stl.size() + 1);
+			q.insert(q.begin() + k, v), stl.insert(stl.begin() + k, v);
+		}
+		else if(!stl.empty() && rnd() % 2) q.pop_front(), stl.pop_front();
+		if(i % 20000 == 0){
+			std::deque<int> got;
+			size_t empty = 0;
+			const sjtu::deque<int> &c = q;
+			c.for_each_segment(Collect{&got, &empty});
+			if(got != stl || empty) ok = 0;
+			for(int j = 0; j < 20; j++){
+				size_t l = rnd() % (stl.size() + 1), r = l + rnd() % (stl.size() - l + 1);
+				got.clear();
+				c.for_each_segment(c.cbegin() + l, c.cbegin() + r, Collect{&got, &empty});
+				if(got != std::deque<int>(stl.begin() + l, stl.begin() + r) || empty) ok = 0;
+			}
+		}
+	}
+	q.for_each_segment([](int *first, int *last){for(; first != last; ++first) *first *= 2;});
+	for(size_t i = 0; i < stl.size(); i++) if(q[i] != stl[i] * 2) ok = 0;
+	puts(ok ? "segments ok" : "segments wrong");
+
+	sjtu::thread_pool pool(3);
+	std::atomic<long long> sum(0);
+	long long expect = 0;
+	for(size_t i = 0; i < stl.size(); i++) expect += stl[i] * 2;
+	pool.for_each_segment(q, [&sum](int *first, int *last){
+		long long s = 0;
+		for(; first != last; ++first) s += *first;
+		sum += s;
+	});
+	puts(sum == expect ? "pool ok" : "pool wrong");
+
+	sjtu::deque<int> other;
+	try{
+		q.for_each_segment(other.begin(), other.end(), [](int *, int *){});
+		puts("no throw");
+	}catch(sjtu::invalid_iterator &){
+		puts("invalid_iterator");
+	}
+	try{
+		q.for_each_segment(q.begin() + 5, q.begin() + 2, [](int *, int *){});
+		puts("no throw");
+	}catch(sjtu::invalid_iterator &){
+		puts("invalid_iterator");
+	}
+	return 0;
+}
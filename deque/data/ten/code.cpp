@@ -0,0 +1,39 @@
+#include <iostream>
+#include <cstdio>
+#include "deque.hpp"
+#include "exceptions.hpp"
+
+//queue workloads: pushes and pops at both ends, interleaved with random access and iteration
+int main(){
+	sjtu::deque<int> q;
+	long long sum = 0;
+	int head = 0, tail = 0;//q holds head .. tail - 1
+	for(int step = 0; step < 1000000; step++){
+		if(step % 5 < 3) q.push_back(tail++);
+		else if(!q.empty()) sum += q.front(), q.pop_front(), head++;
+		if(step % 9973 == 0 && !q.empty()){
+			if(q[q.size() / 2] != head + (int)q.size() / 2 || q.back() != tail - 1) puts("wrong element");
+			sjtu::deque<int>::iterator it = q.end() - 1;
+			if(*it != tail - 1 || it - q.begin() != (int)q.size() - 1) puts("wrong iterator");
+		}
+	}
+	printf("%d %d %d %lld\n", (int)q.size(), q.front(), q.back(), sum);
+	for(int i = 1; i <= 300000; i++) q.push_front(head - i);
+	head -= 300000;
+	int cnt = 0;
+	for(sjtu::deque<int>::iterator it = q.begin(); it != q.end(); ++it, ++cnt)
+		if(*it != head + cnt) {puts("wrong scan"); break;}
+	printf("%d %d\n", cnt, q.at(123456));
+	while(q.size() > 10) q.pop_back(), q.pop_front();
+	for(int i = 0; i < (int)q.size(); i++) printf("%d ", q[i]);
+	puts("");
+	while(!q.empty()) q.pop_back();
+	try{
+		q.pop_front();
+	} catch(sjtu::container_is_empty){
+		puts("pop on empty throws");
+	}
+	q.push_front(7), q.push_back(8);
+	printf("%d %d %d\n", (int)q.size(), q.front(), q.back());
+	return 0;
+}
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include "sequence.hpp"
+#include "exceptions.hpp"
+
+//sequence, the treap-of-chunks alternative to deque, against std::deque
+unsigned seed = 1000000007;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+template <class S, class V>
+bool same(S &q, const std::deque<V> &stl){
+	if(q.size() != stl.size()) return 0;
+	int i = 0;
+	for(typename S::iterator it = q.begin(); it != q.end(); ++it, ++i)
+		if(*it != stl[i]) return 0;
+	for(i = 0; i < (int)stl.size(); i += 37)
+		if(q.at(i) != stl[i]) return 0;
+	return 1;
+}
+
+int main(){
+	sjtu::sequence<int> q;
+	std::deque<int> stl;
+	for(int i = 0; i < 200000; i++){
+		int op = rnd() % 6, v = rnd();
+		if(op == 0) q.push_back(v), stl.push_back(v);
+		else if(op == 1) q.push_front(v), stl.push_front(v);
+		else if(op <= 3){
+			size_t p = rnd() % (stl.size() + 1);
+			q.insert(q.begin() + p, v), stl.insert(stl.begin() + p, v);
+		} else if(!stl.empty()){
+			size_t p = rnd() % stl.size();
+			if(op == 4) q.erase(q.begin() + p), stl.erase(stl.begin() + p);
+			else if(rnd() % 2) q.pop_back(), stl.pop_back();
+			else q.pop_front(), stl.pop_front();
+		}
+	}
+	printf("mixed: %s %d\n", same(q, stl) ? "ok" : "wrong", (int)q.size());
+	sjtu::sequence<int> tail = q.split_at(q.size() / 3);
+	std::deque<int> stail(stl.begin() + stl.size() / 3, stl.end());
+	stl.erase(stl.begin() + stl.size() / 3, stl.end());
+	printf("split: %s %s\n", same(q, stl) ? "ok" : "wrong", same(tail, stail) ? "ok" : "wrong");
+	tail.append(std::move(q));
+	stail.insert(stail.end(), stl.begin(), stl.end()), stl.clear();
+	printf("append: %s %s\n", same(tail, stail) ? "ok" : "wrong", q.empty() ? "empty" : "not empty");
+	while(tail.size() > 5) tail.erase(tail.begin() + tail.size() / 2), stail.erase(stail.begin() + stail.size() / 2);
+	printf("drain: %s %d %d\n", same(tail, stail) ? "ok" : "wrong", tail.front(), tail.back());
+
+	sjtu::sequence<std::string> s;
+	for(int i = 0; i < 1000; i++) s.insert(s.begin() + s.size() / 2, std::to_string(i));
+	sjtu::sequence<std::string> s2(s);
+	s.clear();
+	printf("%d %s %s %d\n", (int)s2.size(), s2.front().c_str(), s2[500].c_str(), (int)(s2.end() - 1)->size());
+	return 0;
+}
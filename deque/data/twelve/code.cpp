@@ -0,0 +1,78 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include <vector>
+#include "deque.hpp"
+#include "exceptions.hpp"
+
+//range insert and range erase against std::deque
+unsigned seed = 19260817;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+sjtu::deque<int> q;
+std::deque<int> stl;
+
+bool same(){
+	if(q.size() != stl.size()) return 0;
+	int i = 0;
+	for(sjtu::deque<int>::iterator it = q.begin(); it != q.end(); ++it, ++i)
+		if(*it != stl[i]) return 0;
+	for(i = 0; i < (int)stl.size(); i += 101)
+		if(q.at(i) != stl[i]) return 0;
+	return 1;
+}
+
+int main(){
+	std::vector<int> big;
+	for(int i = 0; i < 100000; i++) big.push_back(i);
+	for(int i = 0; i < 1000; i++) q.push_back(-i), stl.push_back(-i);
+	sjtu::deque<int>::iterator it = q.insert(q.begin() + 500, big.begin(), big.end());
+	stl.insert(stl.begin() + 500, big.begin(), big.end());
+	printf("insert range: %s %d %d\n", same() ? "ok" : "wrong", *it, (int)(it - q.begin()));
+	it = q.insert(q.end(), 3, 7);
+	stl.insert(stl.end(), 3, 7);
+	printf("insert copies: %s %d %d\n", same() ? "ok" : "wrong", *it, (int)q.size());
+	it = q.erase(q.begin() + 100, q.begin() + 90100);
+	stl.erase(stl.begin() + 100, stl.begin() + 90100);
+	printf("erase range: %s %d %d\n", same() ? "ok" : "wrong", *it, (int)q.size());
+	it = q.erase(q.begin() + 5, q.begin() + 5);
+	printf("erase empty range: %d %d\n", *it, (int)q.size());
+	for(int round = 0; round < 300; round++){
+		int op = rnd() % 4;
+		size_t p = rnd() % (stl.size() + 1);
+		if(op == 0){
+			size_t len = rnd() % 3000;
+			q.insert(q.begin() + p, big.begin() + 50, big.begin() + 50 + len);
+			stl.insert(stl.begin() + p, big.begin() + 50, big.begin() + 50 + len);
+		} else if(op == 1){
+			size_t len = rnd() % 50;
+			q.insert(q.begin() + p, len, round);
+			stl.insert(stl.begin() + p, len, round);
+		} else {
+			size_t len = rnd() % (stl.size() - p + 1) % 2000;
+			q.erase(q.begin() + p, q.begin() + p + len);
+			stl.erase(stl.begin() + p, stl.begin() + p + len);
+		}
+		if(!same()){
+			printf("round %d wrong\n", round);
+			return 0;
+		}
+	}
+	printf("random ranges: ok %d\n", (int)q.size());
+	sjtu::deque<int> other(q);
+	q.insert(q.begin() + q.size() / 2, other.begin(), other.end());
+	stl.insert(stl.begin() + stl.size() / 2, stl.begin(), stl.end());
+	printf("insert from another deque: %s %d\n", same() ? "ok" : "wrong", (int)q.size());
+	q.erase(q.begin(), q.end());
+	printf("erase all: %d %s\n", (int)q.size(), q.empty() ? "empty" : "not empty");
+	q.push_back(1), q.push_back(2);
+	try{
+		q.erase(q.end(), q.begin());
+	} catch(...){
+		puts("erase of a reversed range throws");
+	}
+	return 0;
+}
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include "deque.hpp"
+#include "sequence.hpp"
+
+//inserting an element of the container into itself, against std::deque: the value must be read before
+//the shift or the split that makes room for it moves it
+unsigned seed = 1000000007;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+template <class Container>
+bool run(){
+	Container q;
+	std::deque<std::string> stl;
+	for(int i = 0; i < 300; i++){
+		std::string s = std::to_string(i);
+		q.push_back(s), stl.push_back(s);
+	}
+	for(int i = 0; i < 20000; i++){
+		size_t k = rnd() % stl.size(), p = rnd() % (stl.size() + 1);
+		int op = rnd() % 4;
+		if(op == 0){
+			const Container &c = q;
+			q.insert(q.begin() + p, c[k]);
+		}
+		else if(op == 1) q.insert(q.begin() + p, q[k]);
+		else if(op == 2) q.push_back(q[k]);
+		else q.push_front(q[k]);
+		std::string v = stl[k];
+		if(op < 2) stl.insert(stl.begin() + p, v);
+		else if(op == 2) stl.push_back(v);
+		else stl.push_front(v);
+		if(stl.size() > 3000){
+			size_t e = rnd() % stl.size();
+			q.erase(q.begin() + e), stl.erase(stl.begin() + e);
+		}
+	}
+	if(q.size() != stl.size()) return false;
+	for(size_t i = 0; i < stl.size(); i++) if(q[i] != stl[i]) return false;
+	return true;
+}
+
+int main(){
+	puts(run<sjtu::deque<std::string>>() ? "deque ok" : "deque wrong");
+	puts(run<sjtu::sequence<std::string>>() ? "sequence ok" : "sequence wrong");
+	return 0;
+}
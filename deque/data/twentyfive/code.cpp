@@ -0,0 +1,35 @@
+#include <iostream>
+#include <cstdio>
+#include "deque.hpp"
+
+//writing through it-> into a deque that still shares its blocks with a snapshot makes the block its own,
+//which copies the elements. a copy that throws has to reach the caller as an exception, like it does
+//through *it, and leave both deques as they were
+int budget = -1;
+
+struct Item{
+	int val;
+	Item(int v) : val(v) {}
+	Item(const Item &o) : val(o.val) {
+		if(budget == 0) throw 1;
+		if(budget > 0) budget--;
+	}
+};
+
+int main(){
+	sjtu::deque<Item> q;
+	for(int i = 0; i < 1000; i++) q.push_back(Item(i));
+	sjtu::deque<Item> c = q.snapshot();
+	int caught = 0;
+	budget = 10;
+	try { (c.begin() + 500) -> val = -1; } catch(int) { caught++; }
+	budget = 10;
+	try { (*(c.begin() + 500)).val = -1; } catch(int) { caught++; }
+	budget = -1;
+	bool ok = caught == 2;
+	for(int i = 0; i < 1000; i++) if(q[i].val != i || c[i].val != i) { ok = 0; break; }
+	(c.begin() + 500) -> val = -1;
+	if(q[500].val != 500 || c[500].val != -1) ok = 0;
+	printf("%d %s\n", caught, ok ? "ok" : "wrong");
+	return 0;
+}
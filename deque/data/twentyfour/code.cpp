@@ -0,0 +1,45 @@
+#include <iostream>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <vector>
+#include "deque.hpp"
+
+//runs of inserts through it = insert(it, v), ++it, each started at the first slot of a full block,
+//against std::deque. every insert after the first lands at a block boundary, which must fill the
+//neighbouring block or split instead of starting a one-element block each time: 40000 of them have
+//to finish quickly and leave the number of contiguous segments near the square root of the size
+template <class Deque>
+size_t segments(Deque &q){
+	size_t cnt = 0;
+	q.for_each_segment([&cnt](const int *, const int *){ cnt++; });
+	return cnt;
+}
+
+int main(){
+	bool ok = 1;
+	sjtu::deque<int> q;
+	std::deque<int> stl;
+	for(int i = 0; i < 200000; i++) q.push_back(i), stl.push_back(i);
+	std::vector<size_t> cut;
+	size_t at = 0;
+	q.for_each_segment([&cut, &at](const int *first, const int *last){ cut.push_back(at), at += last - first; });
+	clock_t start = clock();
+	int v = -1;
+	for(int r = 0; r < 4; r++){
+		size_t k = cut[cut.size() * (r + 1) / 5];
+		sjtu::deque<int>::iterator it = q.begin() + k;
+		std::deque<int>::iterator s = stl.begin() + k;
+		for(int i = 0; i < 10000; i++, v--) it = q.insert(it, v), ++it, s = stl.insert(s, v), ++s;
+		if(*it != *s) ok = 0;
+		for(size_t j = 0; j < cut.size(); j++) if(cut[j] > k) cut[j] += 10000;
+	}
+	for(int i = 0; i < 10000; i++, v--) q.insert(q.begin(), v), stl.push_front(v), q.insert(q.end(), v), stl.push_back(v);
+	if((double)(clock() - start) / CLOCKS_PER_SEC > 10) ok = 0, puts("boundary inserts too slow");
+	size_t s = segments(q);
+	if(s * s > 64 * q.size() + 256) ok = 0, puts("boundary inserts left too many blocks");
+	if(q.size() != stl.size()) ok = 0;
+	else for(size_t i = 0; i < stl.size(); i++) if(q[i] != stl[i]) { ok = 0; break; }
+	puts(ok ? "ok" : "wrong");
+	return 0;
+}
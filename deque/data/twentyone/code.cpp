@@ -0,0 +1,35 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include "deque.hpp"
+
+//grow the deque, shrink it from either end so block_size drops while the big old blocks stay, then insert
+//and erase in the middle against std::deque: splitting an old block must not overflow the new one
+unsigned seed = 1000000007;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+int main(){
+	bool ok = 1;
+	for(int round = 0; round < 6; round++){
+		sjtu::deque<int> q;
+		std::deque<int> stl;
+		int n = 100000 >> round % 3, keep = 3000 >> round / 3;
+		for(int i = 0; i < n; i++) q.push_back(i), stl.push_back(i);
+		while((int)stl.size() > keep){
+			if(round & 1) q.pop_front(), stl.pop_front();
+			else q.pop_back(), stl.pop_back();
+		}
+		for(int i = 0; i < 5000; i++){
+			size_t k = rnd() % (stl.size() + 1);
+			if(rnd() % 3 || stl.empty()) q.insert(q.begin() + k, -i), stl.insert(stl.begin() + k, -i);
+			else if(k < stl.size()) q.erase(q.begin() + k), stl.erase(stl.begin() + k);
+		}
+		if(q.size() != stl.size()) ok = 0;
+		else for(size_t i = 0; i < stl.size(); i++) if(q[i] != stl[i]) ok = 0;
+	}
+	puts(ok ? "ok" : "wrong");
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <deque>
+#include <algorithm>
+#include "sequence.hpp"
+
+//repeated split_at and append on a sequence, against std::deque: a split cuts one chunk in two,
+//so the seams have to be merged again or the chunks pile up. the bytes held from operator new
+//are tracked and must stay within a small multiple of the elements
+size_t held = 0;
+
+void *operator new(size_t n){
+	size_t *p = (size_t *)malloc(n + sizeof(max_align_t));
+	if(!p) throw std::bad_alloc();
+	*p = n, held += n;
+	return (char *)p + sizeof(max_align_t);
+}
+void operator delete(void *p) noexcept{
+	if(!p) return;
+	size_t *q = (size_t *)((char *)p - sizeof(max_align_t));
+	held -= *q, free(q);
+}
+void *operator new[](size_t n){return operator new(n);}
+void operator delete[](void *p) noexcept{operator delete(p);}
+void operator delete(void *p, size_t) noexcept{operator delete(p);}
+void operator delete[](void *p, size_t) noexcept{operator delete(p);}
+
+unsigned seed = 1000000007;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+int main(){
+	bool ok = 1;
+	sjtu::sequence<int> q;
+	std::deque<int> stl;
+	for(int i = 0; i < 100000; i++) q.push_back(i), stl.push_back(i);
+	size_t base = held;
+	for(int i = 0; i < 20000; i++){
+		size_t k = rnd() % (stl.size() + 1);
+		sjtu::sequence<int> tail = q.split_at(k);
+		if(i % 3 == 0) q.append(std::move(tail));
+		else{//rotate: the tail goes in front
+			sjtu::sequence<int> head = q.split_at(0);
+			q.append(std::move(tail)), q.append(std::move(head));
+			std::rotate(stl.begin(), stl.begin() + k, stl.end());
+		}
+		if(!tail.empty()) ok = 0;
+	}
+	if(held > base * 2) ok = 0, puts("splits left too many chunks");
+	for(int i = 0; i < 2000; i++){
+		size_t k = rnd() % (stl.size() + 1), len = rnd() % 100;
+		sjtu::sequence<int> tail = q.split_at(k), mid;
+		for(size_t j = 0; j < len; j++) mid.push_back(-i);
+		q.append(std::move(mid)), q.append(std::move(tail));
+		stl.insert(stl.begin() + k, len, -i);
+	}
+	if(q.size() != stl.size()) ok = 0;
+	else for(size_t i = 0; i < stl.size(); i++) if(q[i] != stl[i]) { ok = 0; break; }
+	puts(ok ? "ok" : "wrong");
+	return 0;
+}
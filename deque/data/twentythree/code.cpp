@@ -0,0 +1,69 @@
+#include <iostream>
+#include <cstdio>
+#include <deque>
+#include "deque.hpp"
+
+//appends and splices of many small deques, against std::deque. the seams must be merged and the blocks
+//kept few: the number of contiguous segments (at most two per block) has to stay near the square root of
+//the size, and 200000 single appends have to finish quickly
+unsigned seed = 1000000007;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+template <class Deque>
+size_t segments(Deque &q){
+	size_t cnt = 0;
+	q.for_each_segment([&cnt](const int *, const int *){ cnt++; });
+	return cnt;
+}
+
+bool few(sjtu::deque<int> &q){
+	size_t s = segments(q);
+	return s * s <= 64 * q.size() + 256;
+}
+
+int main(){
+	bool ok = 1;
+	sjtu::deque<int> q;
+	std::deque<int> stl;
+	for(int i = 0; i < 200000; i++){
+		sjtu::deque<int> one;
+		one.push_back(i), q.append(std::move(one)), stl.push_back(i);
+	}
+	if(!few(q)) ok = 0, puts("single appends left too many blocks");
+	sjtu::deque<int> r;
+	for(int i = 0; i < 2000; i++){
+		sjtu::deque<int> h;
+		for(int j = 0; j < 100; j++) h.push_back(i * 100 + j);
+		r.append(std::move(h));
+	}
+	if(!few(r)) ok = 0, puts("small appends left too many blocks");
+	for(int i = 0; i < 200000; i++) if(r[i] != i) { ok = 0; break; }
+	for(int i = 0; i < 3000; i++){
+		int op = rnd() % 4, len = rnd() % 50;
+		size_t k = rnd() % (stl.size() + 1);
+		if(op == 0){
+			sjtu::deque<int> o;
+			for(int j = 0; j < len; j++) o.push_front(-j);
+			q.splice(q.begin() + k, o);
+			for(int j = 0; j < len; j++) stl.insert(stl.begin() + k + j, -(len - 1 - j));
+			if(!o.empty()) ok = 0;
+		}
+		else if(op == 1){
+			size_t e = k + len < stl.size() ? k + len : stl.size();
+			q.erase(q.begin() + k, q.begin() + e), stl.erase(stl.begin() + k, stl.begin() + e);
+		}
+		else if(op == 2) q.insert(q.begin() + k, (size_t)len, i), stl.insert(stl.begin() + k, len, i);
+		else{
+			sjtu::deque<int> tail = q.split_at(k);
+			q.append(std::move(tail));
+		}
+	}
+	if(!few(q)) ok = 0, puts("splices left too many blocks");
+	if(q.size() != stl.size()) ok = 0;
+	else for(size_t i = 0; i < stl.size(); i++) if(q[i] != stl[i]) { ok = 0; break; }
+	puts(ok ? "ok" : "wrong");
+	return 0;
+}
@@ -0,0 +1,31 @@
+#include <iostream>
+#include <cstdio>
+#include <thread>
+#include "deque.hpp"
+
+//several threads read one const deque at once, right after pushes at both ends left size changes of the
+//end blocks pending; lookups (iterators, at and []) must not write anything, so every thread sees every
+//element in place
+const int N = 200000, THREADS = 4;
+
+void reader(const sjtu::deque<int> *q, int t, bool *ok){
+	for(int i = t; i < (int)q -> size(); i += 7){
+		sjtu::deque<int>::const_iterator it = q -> cbegin() + i;
+		if(*it != i - N / 2 - 50 || q -> at(i) != *it || (*q)[i] != *it) *ok = 0;
+	}
+}
+
+int main(){
+	sjtu::deque<int> q;
+	for(int i = 0; i < N / 2; i++) q.push_back(i), q.push_front(-i - 1);
+	for(int i = 0; i < 1000; i++) q.insert(q.begin() + N / 2, 0), q.erase(q.begin() + N / 2);
+	for(int i = 0; i < 50; i++) q.push_front(-N / 2 - 1 - i), q.push_back(N / 2 + i);
+	std::thread threads[THREADS];
+	bool ok[THREADS];
+	for(int t = 0; t < THREADS; t++) ok[t] = 1, threads[t] = std::thread(reader, &q, t, ok + t);
+	for(int t = 0; t < THREADS; t++) threads[t].join();
+	bool all = 1;
+	for(int t = 0; t < THREADS; t++) all &= ok[t];
+	puts(all ? "ok" : "wrong");
+	return 0;
+}
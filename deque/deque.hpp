@@ -4,7 +4,12 @@
 #include "exceptions.hpp"
 #include "utility.hpp"
 
+#include <atomic>
 #include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace sjtu
 {
@@ -13,171 +18,480 @@ class deque
 {
 private:
 	size_t total_size , total_space , block_size;
+	size_t epoch;//bumped by every modification, so iterators know when their cached position is stale
+	static std::atomic<size_t> relocations;//shared by all deques of this type, so bumped atomically
 
-	struct Node
+	//moves the element in src to the raw slot dst
+	static void relocate(T *dst , T *src) {new (dst) T (std::move(*src)) , src -> ~T();}
+	//counts the n relocations of one operation with a single atomic add
+	static void relocated(const size_t &n) {if (n) relocations.fetch_add(n , std::memory_order_relaxed);}
+	//copies for Block::own; only snapshot() shares stores and it asks for a copyable T, so a move-only T
+	//never gets here
+	static void clone(T *dst , const T *src , std::true_type) {new (dst) T (*src);}
+	static void clone(T * , const T * , std::false_type) {}
+
+	struct Block;
+
+	//the storage of a block: refs blocks of this or other deques read the same elements, inline after
+	//the counts; a store with more than one reference is never written. a store made with a block is
+	//housed: the header of that block sits right before it in the same allocation, so a block that is
+	//never shared is one allocation with the header, the counts and the elements adjacent. pins counts
+	//the readers and the housed header, and the allocation goes when both are gone
+	struct alignas(T) alignas(std::atomic<size_t>) Store
 	{
-		T *value;
-		Node *prec , *succ;
+		std::atomic<size_t> refs , pins;
+		bool housed;
 
-		explicit Node (T * const &value_ = nullptr) : value(value_) , prec(nullptr) , succ(nullptr) {}
-		Node (const Node &other) : value(other.value == nullptr ? nullptr : new T (*other.value)) , prec(nullptr) , succ(nullptr) {}
-		Node &operator=(const Node &other) = delete;
-		~Node () {delete value;}
+		Store(const size_t &readers , const bool &housed_) : refs(readers) , pins(readers + housed_) , housed(housed_) {}
+
+		//a store of cap slots read by readers blocks, with room for a header before it if housed
+		static Store *make(const size_t &cap , const size_t &readers , const bool &housed)
+		{
+			size_t room = housed ? sizeof(Block) : 0;
+			char *raw = static_cast<char *>(::operator new(room + sizeof(Store) + cap * sizeof(T)));
+			return new (raw + room) Store (readers , housed);
+		}
+		Block *header() const {return reinterpret_cast<Block *>(const_cast<Store *>(this)) - 1;}
+		void unpin()
+		{
+			if (pins.fetch_sub(1 , std::memory_order_acq_rel) == 1) ::operator delete(housed ? static_cast<void *>(header()) : this);
+		}
+		T *data() const {return reinterpret_cast<T *>(const_cast<Store *>(this) + 1);}
 	};
 
-	static Node *find_tail(Node *node)
+	//a ring buffer of cap elements, tot of them alive starting at data()[head]
+	//a snapshot copies the headers only, so blocks share stores until one side calls own()
+	struct alignas(Store) Block
 	{
-		for (;node -> succ;node = node -> succ);
-		return node;
+		size_t head , tot , cap , id;//id is the position of the block in dir
+		Block *prec , *succ;
+		Store *store;
+
+		Block(const size_t &cap_ , Store * const &store_) : head(0) , tot(0) , cap(cap_) , id(0) , prec(nullptr) , succ(nullptr) , store(store_) {}
+		Block(const Block &other) : head(other.head) , tot(other.tot) , cap(other.cap) , id(0) , prec(nullptr) , succ(nullptr) , store(other.store)
+		{
+			store -> refs.fetch_add(1 , std::memory_order_relaxed) , store -> pins.fetch_add(1 , std::memory_order_relaxed);
+		}
+		Block &operator=(const Block &other) = delete;
+		~Block() {release();}
+
+		//blocks are created only through make, each in the allocation of its home store; delete
+		//lets go of the home, which a shared store or the clone made by own() may have replaced
+		static Block *make(const size_t &cap)
+		{
+			Store *home = Store::make(cap , 1 , true);
+			return new (home -> header()) Block (cap , home);
+		}
+		static Block *make(const Block &other) {return new (Store::make(0 , 0 , true) -> header()) Block (other);}
+		static void *operator new(size_t , void *p) {return p;}
+		static void operator delete(void *p) {reinterpret_cast<Store *>(static_cast<Block *>(p) + 1) -> unpin();}
+
+		//stops reading store, destroying the elements if no other block reads them
+		void release()
+		{
+			if (store -> refs.fetch_sub(1 , std::memory_order_acq_rel) == 1) for (size_t i = 0;i < tot;++ i) slot(i) -> ~T();
+			store -> unpin();
+		}
+
+		T *data() const {return store -> data();}
+		T *slot(const size_t &i) const {return data() + (head + i < cap ? head + i : head + i - cap);}
+		T &operator[](const size_t &i) const {return *slot(i);}
+		//whether p points into the storage of this block
+		bool holds(const T *p) const {return !std::less<const T *>()(p , data()) && std::less<const T *>()(p , data() + cap);}
+
+		//called before anything writes to the elements: a shared store is replaced by a private copy,
+		//allocated on its own. a copy that throws leaves the block sharing the old store
+		void own()
+		{
+			if (store -> refs.load(std::memory_order_acquire) == 1) return;
+			Store *nstore = Store::make(cap , 1 , false);
+			size_t i = 0;
+			try {for (;i < tot;++ i) clone(nstore -> data() + i , slot(i) , std::is_copy_constructible<T>());}
+			catch (...)
+			{
+				while (i) nstore -> data()[-- i].~T();
+				nstore -> unpin();
+				throw;
+			}
+			release() , store = nstore , head = 0;
+		}
+
+		template <class... Args>
+		void insert(const size_t &pos , Args &&... args)//tot < cap; args must not refer to elements of this block
+		{
+			own() , relocated(pos < tot - pos ? pos : tot - pos);
+			if (pos < tot - pos)
+			{
+				head = head ? head - 1 : cap - 1;
+				for (size_t i = 0;i < pos;++ i) relocate(slot(i) , slot(i + 1));
+			}
+			else for (size_t i = tot;i > pos;-- i) relocate(slot(i) , slot(i - 1));
+			new (slot(pos)) T (std::forward<Args>(args)...) , ++ tot;
+		}
+
+		void erase(const size_t &pos)
+		{
+			own() , slot(pos) -> ~T() , relocated(pos < tot - pos - 1 ? pos : tot - pos - 1);
+			if (pos < tot - pos - 1)
+			{
+				for (size_t i = pos;i;-- i) relocate(slot(i) , slot(i - 1));
+				head = head + 1 == cap ? 0 : head + 1;
+			}
+			else for (size_t i = pos;i + 1 < tot;++ i) relocate(slot(i) , slot(i + 1));
+			-- tot;
+		}
+	}*Blk , *blkend;
+	//only an empty deque has an empty block; a position (blk, blk -> tot) is only used for end()
+
+	//dir holds the cnt blocks in order in slots base .. base + cnt - 1, leaving free slots on both sides so
+	//blocks can come and go at the ends without reindexing; fen is a fenwick tree over the sizes of all
+	//dir_space slots (1-indexed), free slots counting as empty blocks
+	Block **dir;
+	size_t *fen , cnt , base , dir_space;
+	size_t front_lag , back_lag;//size changes of Blk and blkend by push and pop, not yet in fen
+	Block *finger;//the block non-const at() last landed in, holding the elements from finger_start on
+	size_t finger_start , finger_epoch;//the finger is trusted only while finger_epoch == epoch
+
+	//rebuilds dir and fen in O(cnt) after blocks have been added or removed in the middle, recentring them
+	void reindex()
+	{
+		cnt = 0;
+		for (Block *blk = Blk;blk;blk = blk -> succ) blkend = blk , ++ cnt;
+		if (dir_space < cnt << 1 || (dir_space > 8 && dir_space > cnt << 3))
+		{
+			for (dir_space = 4;dir_space < cnt << 1;dir_space <<= 1);
+			delete [] dir , delete [] fen;
+			dir = new Block * [dir_space] , fen = new size_t [dir_space + 1];
+		}
+		size_t i = base = dir_space - cnt >> 1;
+		for (Block *blk = Blk;blk;blk = blk -> succ) blk -> id = i , dir[i ++] = blk;
+		for (i = 1;i <= dir_space;++ i) fen[i] = i > base && i <= base + cnt ? dir[i - 1] -> tot : 0;
+		for (i = 1;i <= dir_space;++ i)
+			if (i + (i & -i) <= dir_space) fen[i + (i & -i)] += fen[i];
+		front_lag = back_lag = 0;
 	}
 
-	static Node *list_copy(Node * const &other)
+	void resize_block(const Block *blk , const size_t &delta) const//delta may wrap around to subtract
 	{
-		if (other == nullptr) return nullptr;
-		Node *node = new Node (*other);
-		if (node -> succ = list_copy(other -> succ)) node -> succ -> prec = node;
-		return node;
+		for (size_t i = blk -> id + 1;i <= dir_space;i += i & -i) fen[i] += delta;
 	}
 
-	static void list_clear(Node *&node)
+	//writes the lagging sizes of the end blocks to fen; needed before the end blocks change
+	void flush()
 	{
-		if (node == nullptr) return;
-		list_clear(node -> succ) , delete node , node = nullptr;
+		if (front_lag) resize_block(Blk , front_lag) , front_lag = 0;
+		if (back_lag) resize_block(blkend , back_lag) , back_lag = 0;
 	}
 
-	struct Block
+	//indexes an empty block just linked in at the back or the front, flush() must have been called before linking
+	void attach(Block *nblk , bool back)
 	{
-		Node *head , *tail;
-		Block *prec , *succ;
-		size_t tot;
+		if (back ? base + cnt == dir_space : !base) return reindex();
+		nblk -> id = back ? base + cnt : -- base;
+		dir[nblk -> id] = nblk , ++ cnt;
+	}
 
-		Block() : head(nullptr) , tail(nullptr) , prec(nullptr) , succ(nullptr) , tot(0) {}
-		Block(Node * const &node) : head(node) , tail(node) , prec(nullptr) , succ(nullptr) , tot(1) {}
-		Block(Node * const &head_, Node * const &tail_ , const size_t &tot_) : head(head_) , tail(tail_) , prec(nullptr) , succ(nullptr) , tot(tot_) {}
-		Block (const Block &other) : head(list_copy(other.head)) , tail(find_tail(head)) , tot(other.tot) {}
-		Block &operator=(const Block &other) = delete;
-		~Block() {list_clear(head);}
-	}*Blk;
+	//forgets an empty block just unlinked from the back or the front, flush() must have been called before unlinking
+	void detach(bool back) {back ? -- cnt : (++ base , -- cnt);}
 
-	pair<Block * , Node *> nodeend;
+	//the position of the element with index pos, (blkend, blkend -> tot) if pos == total_size.
+	//only reads, so a const deque can be read from several threads: the end blocks are answered from their
+	//own sizes, and the search adds the lags to the sums of fen that cover an end block
+	pair<Block * , size_t> locate(size_t pos) const
+	{
+		if (pos < Blk -> tot) return pair<Block * , size_t>(Blk , pos);
+		if (pos >= total_size - blkend -> tot) return pair<Block * , size_t>(blkend , pos - (total_size - blkend -> tot));
+		size_t id = 0 , first = base + 1 , last = base + cnt;//the slots of Blk and blkend in fen
+		for (size_t step = dir_space , sum;step;step >>= 1)
+		{
+			if (id + step > dir_space) continue;
+			sum = fen[id + step] + (id < first && first <= id + step ? front_lag : 0) + (id < last && last <= id + step ? back_lag : 0);
+			if (sum <= pos) id += step , pos -= sum;
+		}
+		return pair<Block * , size_t>(dir[id] , pos);
+	}
 
-	/*void merge(Block *lhs , Block *rhs)//lhs and rhs are not empty
+	//locate for non-const at(): walks from the finger when pos is within a few blocks of it, so runs of
+	//nearby accesses skip the search from the root of fen; a far pos goes to locate without touching a block.
+	//const at() does not use it, since moving the finger is a write and const reads may run in parallel
+	pair<Block * , size_t> touch(const size_t &pos)
 	{
-		(lhs -> tail -> succ = rhs -> head) -> prec = lhs -> tail , lhs -> tot += rhs -> tot , lhs -> tail = rhs -> tail;
-		rhs -> head = nullptr , delete rhs;
-		if ((lhs -> succ = rhs -> succ) == nullptr) nodeend.first = lhs , nodeend.second = lhs -> tail;
-	}*/
+		static const size_t reach = 8;
+		if (finger && finger_epoch == epoch && (pos < finger_start ? finger_start - pos : pos - finger_start) <= block_size << 1)
+		{
+			Block *blk = finger;
+			size_t start = finger_start;
+			for (size_t hop = 0;blk && hop <= reach;++ hop)
+				if (pos < start) {if (blk = blk -> prec) start -= blk -> tot;}
+				else if (pos - start >= blk -> tot) start += blk -> tot , blk = blk -> succ;
+				else return finger = blk , finger_start = start , pair<Block * , size_t>(blk , pos - start);
+		}
+		pair<Block * , size_t> loc = locate(pos);
+		finger = loc.first , finger_start = pos - loc.second , finger_epoch = epoch;
+		return loc;
+	}
 
-	void split(Block *blk)//blk.size() >= 2
+	//blk may have been built before block_size shrank, so the new block is no smaller than blk: either half
+	//must still have room for the insertion that caused the split
+	void split(Block *blk)//blk -> tot >= 2
 	{
-		Node *mid = blk -> head;
-		for (int i = 1;i + 1 <= (blk -> tot + 1 >> 1);++ i) mid = mid -> succ;
-		mid -> succ -> prec = nullptr;
-		Block *nblk = new Block (mid -> succ , blk -> tail , blk -> tot >> 1);
-		mid -> succ = nullptr , blk -> tot -= nblk -> tot;
+		size_t mid = blk -> tot + 1 >> 1;
+		Block *nblk = Block::make(blk -> cap > block_size << 1 ? blk -> cap : block_size << 1);
+		blk -> own() , relocated(blk -> tot - mid);
+		for (size_t i = mid;i < blk -> tot;++ i) relocate(nblk -> slot(nblk -> tot ++) , blk -> slot(i));
+		blk -> tot = mid;
 		if (nblk -> succ = blk -> succ) nblk -> succ -> prec = nblk;
-		((blk -> succ = nblk) -> prec = blk) -> tail = mid;
-		if (nblk -> succ == nullptr) nodeend.first = nblk , nodeend.second = nblk -> tail;
+		else blkend = nblk;
+		(blk -> succ = nblk) -> prec = blk;
 	}
 
-	pair<Block * , Node *> maintain(Block *blk , pair<Block * , Node *> pos , bool opt)//to do : return value
+	//makes room in the block of pos before an insertion. at a boundary of a full block the neighbour on
+	//that side takes the element if it has room; a new block is only started at the very front or back,
+	//where it is indexed without a reindex, and anywhere else the full block is split
+	pair<Block * , size_t> maintain(pair<Block * , size_t> pos)
 	{
-		/*if (!opt && blk -> tot < block_size)
-		{
-			Block *blk_ = nullptr;
-			if (blk -> prec)
-			{
-				if (pos.first == blk) pos.first = blk_;
-				merge(blk_ = blk -> prec , blk);
-			}
-			else if (blk -> succ)
-			{
-				if (pos.first == blk -> succ) pos.first = blk;
-				merge(blk_ = blk , blk -> succ);
-			}
-			if (blk_) blk = blk_ , opt = 1;
-		}*/
-		if (opt && blk -> tot >= (block_size << 1))
+		Block *blk = pos.first;
+		if (blk -> tot < blk -> cap) return pos;
+		if (!pos.second && blk -> prec && blk -> prec -> tot < blk -> prec -> cap) return pair<Block * , size_t>(blk -> prec , blk -> prec -> tot);
+		if (pos.second == blk -> tot && blk -> succ && blk -> succ -> tot < blk -> succ -> cap) return pair<Block * , size_t>(blk -> succ , 0);
+		if ((!pos.second && !blk -> prec) || (pos.second == blk -> tot && !blk -> succ))
 		{
-			split(blk);bool found = 0;
-			if (pos.first == blk)
-			{
-				for (Node *node = blk -> head;node != nullptr && !found;node = node -> succ) found |= node == pos.second;
-				if (!found) pos.first = pos.first -> succ;
-			}
+			Block *nblk = Block::make(block_size << 1);
+			flush();
+			if (pos.second) (blkend = blk -> succ = nblk) -> prec = blk;
+			else (Blk = blk -> prec = nblk) -> succ = blk;
+			attach(nblk , pos.second);
+			return pair<Block * , size_t>(nblk , 0);
 		}
+		split(blk) , reindex();
+		if (pos.second > pos.first -> tot) pos.second -= pos.first -> tot , pos.first = pos.first -> succ;
 		return pos;
 	}
 
-	pair<Block * , Node *> rebuild(pair<Block * , Node *> pos)
+	//keeps block_size at the square root of total_space, which doubles when the deque fills it and halves
+	//when the deque drops below a quarter of it; blocks already built keep their storage and their elements,
+	//only blocks made or merged later get the new capacity
+	void rebuild()
+	{
+		for (;total_size >= total_space;)
+			for (total_space <<= 1;(block_size + 1) * (block_size + 1) <= total_space;++ block_size);
+		for (;total_space > 4 && total_size < total_space >> 2;)
+			for (total_space >>= 1;block_size > 2 && block_size * block_size > total_space;-- block_size);
+	}
+
+	//moves all elements of src to the back or the front of dst, which must have room for them
+	static void absorb(Block *dst , Block *src , bool back)
 	{
-		if (total_size < total_space) return pos;
-		pair<Block * , Node *> ret;
-		for (total_space <<= 1;(block_size + 1) * (block_size + 1) <= total_space;++ block_size);
-		Block *Blk_ = new Block , *curblk = Blk_;
-		for (Block *nxt;Blk;Blk = nxt)
+		dst -> own() , src -> own() , relocated(src -> tot);
+		if (back) for (size_t i = 0;i < src -> tot;++ i) relocate(dst -> slot(dst -> tot ++) , src -> slot(i));
+		else for (size_t i = src -> tot;i --;++ dst -> tot) dst -> head = dst -> head ? dst -> head - 1 : dst -> cap - 1 , relocate(dst -> slot(0) , src -> slot(i));
+		src -> tot = 0;
+	}
+
+	void unlink(Block *blk)
+	{
+		if (blk -> prec) blk -> prec -> succ = blk -> succ;
+		else Blk = blk -> succ;
+		if (blk -> succ) blk -> succ -> prec = blk -> prec;
+		else blkend = blk -> prec;
+		delete blk;
+	}
+
+	//puts nblk in place of the blocks from fst to lst, which are freed
+	void replace(Block *fst , Block *lst , Block *nblk)
+	{
+		if (nblk -> prec = fst -> prec) nblk -> prec -> succ = nblk;
+		else Blk = nblk;
+		if (nblk -> succ = lst -> succ) nblk -> succ -> prec = nblk;
+		else blkend = nblk;
+		for (Block *nxt;fst != nblk -> succ;fst = nxt) nxt = fst -> succ , delete fst;
+	}
+
+	//once blk holds fewer than block_size / 2 elements, merges it into a neighbour with room, or with its
+	//smaller neighbour into a new block, or at least moves it to smaller storage; returns whether blocks changed
+	bool merge(Block *blk)
+	{
+		if (blk -> tot >= block_size >> 1) return false;
+		Block *prec = blk -> prec , *succ = blk -> succ;
+		if (prec && prec -> tot + blk -> tot <= prec -> cap) return absorb(prec , blk , true) , unlink(blk) , true;
+		if (succ && succ -> tot + blk -> tot <= succ -> cap) return absorb(succ , blk , false) , unlink(blk) , true;
+		Block *nb = prec && (!succ || prec -> tot <= succ -> tot) ? prec : succ;
+		if (nb && nb -> tot + blk -> tot <= block_size << 1)
+		{
+			Block *fst = nb == prec ? prec : blk , *nblk = Block::make(block_size << 1);
+			absorb(nblk , fst , true) , absorb(nblk , fst -> succ , true) , replace(fst , fst -> succ , nblk);
+			return true;
+		}
+		if (blk -> cap <= block_size << 2) return false;
+		Block *nblk = Block::make(block_size << 1);
+		absorb(nblk , blk , true) , replace(blk , blk , nblk);
+		return true;
+	}
+
+	//fills this empty deque with n elements copied from *first, *++first, ... if step, or all from *first,
+	//in whole blocks of the capacity its new size calls for
+	template <class InputIterator>
+	void build(InputIterator first , const size_t &n , bool step)
+	{
+		if (!n) return;
+		total_size = n , rebuild();
+		Block *cur = Block::make(block_size << 1);
+		delete Blk , Blk = cur;
+		for (size_t i = 0;i < n;++ i)
+		{
+			if (cur -> tot == cur -> cap) (cur -> succ = Block::make(block_size << 1)) -> prec = cur , cur = cur -> succ;
+			new (cur -> slot(cur -> tot)) T (*first) , ++ cur -> tot;
+			if (step) ++ first;
+		}
+		++ epoch , reindex();
+	}
+
+	//calls f(first, last) on the contiguous runs of the n elements from index on, at most two per block
+	template <class Pointer , class Function>
+	void segments(const size_t &index , size_t n , Function &f) const
+	{
+		if (!n) return;
+		pair<Block * , size_t> pos = locate(index);
+		for (Block *blk = pos.first;n;blk = blk -> succ , pos.second = 0)
+		{
+			if (!std::is_const<typename std::remove_pointer<Pointer>::type>::value) blk -> own();
+			size_t k = blk -> tot - pos.second < n ? blk -> tot - pos.second : n , run;
+			T *first = blk -> slot(pos.second);
+			run = blk -> cap - (first - blk -> data()) < k ? blk -> cap - (first - blk -> data()) : k;
+			f(Pointer(first) , Pointer(first + run));
+			if (run < k) f(Pointer(blk -> data()) , Pointer(blk -> data() + k - run));
+			n -= k;
+		}
+	}
+
+	//when blkend or the first block b of other is underfull, moves b into blkend, or both into a new block
+	//in the slot of blkend; b is then taken off other's list. fen must be flushed
+	void seam(deque &other)
+	{
+		Block *a = blkend , *b = other.Blk , *nblk = a;
+		size_t moved = b -> tot;
+		if (a -> tot >= block_size >> 1 && b -> tot >= block_size >> 1) return;
+		if (a -> tot + b -> tot > a -> cap)
+		{
+			if (a -> tot + b -> tot > block_size << 1) return;
+			nblk = Block::make(block_size << 1) , absorb(nblk , a , true);
+			if (nblk -> prec = a -> prec) nblk -> prec -> succ = nblk;
+			else Blk = nblk;
+			nblk -> id = a -> id , dir[a -> id] = nblk , blkend = nblk , delete a;
+		}
+		absorb(nblk , b , true) , resize_block(nblk , moved);
+		if (other.Blk = b -> succ) other.Blk -> prec = nullptr;
+		delete b;
+	}
+
+	//moves every element into whole blocks of the capacity the size calls for; append runs it once blocks
+	//brought in from smaller deques have grown too many for the size
+	void repack()
+	{
+		Block *first = Block::make(block_size << 1) , *cur = first;
+		for (Block *blk = Blk , *nxt;blk;blk = nxt)
 		{
-			for (Node *nxt_;Blk -> head;Blk -> head = nxt_)
+			blk -> own() , relocated(blk -> tot);
+			for (size_t i = 0;i < blk -> tot;++ i)
 			{
-				if (curblk -> tot + 1 == (block_size << 1)) (curblk -> succ = new Block) -> prec = curblk , curblk = curblk -> succ;
-				if (curblk -> tail == nullptr) curblk -> tail = curblk -> head = new Node (*(Blk -> head));
-				else (curblk -> tail -> succ = new Node (*(Blk -> head))) -> prec = curblk -> tail , curblk -> tail = curblk -> tail -> succ;
-				if (Blk -> head == pos.second) ret.first = curblk , ret.second = curblk -> tail;
-				++ curblk -> tot , nxt_ = Blk -> head -> succ , delete Blk -> head;
+				if (cur -> tot == cur -> cap) (cur -> succ = Block::make(block_size << 1)) -> prec = cur , cur = cur -> succ;
+				relocate(cur -> slot(cur -> tot ++) , blk -> slot(i));
 			}
-			nxt = Blk -> succ , delete Blk;
+			blk -> tot = 0 , nxt = blk -> succ , delete blk;
 		}
-		Blk = Blk_ , nodeend.first = curblk , nodeend.second = curblk -> tail;
-		return ret;
+		Blk = first , ++ epoch , reindex();
 	}
 
-	Block *copy(Block * const &blk)//total_size remains unchanged
+	//inserts the elements of mid before index
+	void insert(const size_t &index , deque &mid)
 	{
-		if (blk == nullptr) return nullptr;
-		Block *blk_ = new Block (*blk);
-		if (blk_ -> succ = copy(blk -> succ)) blk_ -> succ -> prec = blk_;
-		return blk_;
+		deque tail = split_at(index);
+		append(std::move(mid)) , append(std::move(tail));
 	}
 
-	void clear(Block *&blk)//total_size remains unchanged
+	//fills this empty deque with copies of the elements of other in one pass, packed into whole blocks
+	//of the capacity its size calls for, so underfull blocks of other are not carried over
+	void copy(const deque &other)
+	{
+		if (!other.total_size) return;
+		total_size = other.total_size , rebuild();
+		Block *cur = Block::make(block_size << 1);
+		delete Blk , Blk = cur;
+		for (const Block *blk = other.Blk;blk;blk = blk -> succ)
+			for (size_t i = 0 , k;i < blk -> tot;i += k , cur -> tot += k)//k elements contiguous in both blocks at a time
+			{
+				if (cur -> tot == cur -> cap) (cur -> succ = Block::make(block_size << 1)) -> prec = cur , cur = cur -> succ;
+				const T *src = blk -> slot(i);
+				k = blk -> tot - i;
+				if (k > blk -> cap - (src - blk -> data())) k = blk -> cap - (src - blk -> data());
+				if (k > cur -> cap - cur -> tot) k = cur -> cap - cur -> tot;
+				for (T *dst = cur -> data() + cur -> tot , *end = dst + k;dst != end;) new (dst ++) T (*src ++);
+			}
+		++ epoch , reindex();
+	}
+
+	//makes this empty deque a copy of other in O(number of blocks): the new blocks share the stores
+	//of other's, and each side clones a store only when it first writes to it
+	void share(const deque &other)
 	{
-		if (blk == nullptr) return;
-		clear(blk -> succ) , delete blk , blk = nullptr;
+		if (!other.total_size) return;
+		total_size = other.total_size , total_space = other.total_space , block_size = other.block_size;
+		Block *cur = Block::make(*other.Blk);
+		delete Blk , Blk = cur;
+		for (const Block *blk = other.Blk -> succ;blk;blk = blk -> succ) (cur -> succ = Block::make(*blk)) -> prec = cur , cur = cur -> succ;
+		++ epoch , reindex();
 	}
 
-	pair<Block * , Node *> insert(pair<Block * , Node *> node , const T &value)
+	//exchanges everything but the epochs, which both move past either old value: iterators of the
+	//two deques must not trust their cached positions afterwards
+	void swap(deque &other)
 	{
-		Node *node_ = new Node (new T (value));
-		if (node.second -> prec == nullptr) node.second -> prec = node_ , (node.first -> head = node_) -> succ = node.second;
-		else (node_ -> prec = node.second -> prec) -> succ = node_ , (node_ -> succ = node.second) -> prec = node_;
-		++ node.first -> tot , ++ total_size;
-		return rebuild(maintain(node.first , pair<Block * , Node *>(node.first , node_) , 1));
+		std::swap(total_size , other.total_size) , std::swap(total_space , other.total_space) , std::swap(block_size , other.block_size);
+		std::swap(Blk , other.Blk) , std::swap(blkend , other.blkend);
+		std::swap(dir , other.dir) , std::swap(fen , other.fen) , std::swap(cnt , other.cnt) , std::swap(base , other.base) , std::swap(dir_space , other.dir_space);
+		std::swap(front_lag , other.front_lag) , std::swap(back_lag , other.back_lag);
+		std::swap(finger , other.finger) , std::swap(finger_start , other.finger_start) , std::swap(finger_epoch , other.finger_epoch);
+		epoch = other.epoch = (epoch > other.epoch ? epoch : other.epoch) + 1;
 	}
 
-	pair<Block * , Node *> erase(pair<Block * , Node *> node)
+	void clear(Block *&blk)//total_size remains unchanged
 	{
-		pair<Block * , Node *> ret;
-		if (node.first -> tot == 1) node.first -> head = nullptr , ret.first = node.first -> succ , ret.second = node.first -> succ -> head;
-		else if (node.second -> prec == nullptr) (node.first -> head = node.second -> succ) -> prec = nullptr , ret.first = node.first , ret.second = node.first -> head;
-		else if (node.second -> prec -> succ = node.second -> succ) node.second -> succ -> prec = node.second -> prec , ret.first = node.first , ret.second = node.second -> succ;
-		else (node.first -> tail = node.first -> tail -> prec) -> succ = nullptr , ret.first = node.first -> succ , ret.second = node.first -> succ -> head;
-		delete node.second , -- node.first -> tot , -- total_size;
-		if (!node.first -> tot)
+		for (Block *nxt;blk;blk = nxt) nxt = blk -> succ , delete blk;
+	}
+
+	//a value inside the block of pos would be moved by the split or the shift before it is read, so it is
+	//taken out to a temporary first
+	template <class V>
+	pair<Block * , size_t> insert(const pair<Block * , size_t> &pos , V &&value)
+	{
+		if (pos.first -> holds(&value))
 		{
-			if (node.first -> prec) node.first -> prec -> succ = node.first -> succ;
-			else Blk = node.first -> succ;
-			node.first -> succ -> prec = node.first -> prec;
-			delete node.first;
+			T tmp(std::forward<V>(value));
+			return insert(pos , std::move(tmp));
 		}
-		return ret;
+		pair<Block * , size_t> pos_ = maintain(pos);
+		pos_.first -> insert(pos_.second , std::forward<V>(value)) , resize_block(pos_.first , 1) , ++ total_size , ++ epoch , rebuild();
+		return pos_;
+	}
+
+	//erases the first or the last element; the end blocks may run underfull, so only an emptied block is touched
+	void pop(Block *blk , const size_t &pos)
+	{
+		bool back = blk == blkend;
+		blk -> erase(pos) , -- (back ? back_lag : front_lag) , -- total_size , ++ epoch , rebuild();
+		if (blk -> tot) return;
+		if (blk -> prec || blk -> succ) flush() , unlink(blk) , detach(back);
+		else if (merge(blk)) reindex();
 	}
 
-	void findend()
+	void erase(const pair<Block * , size_t> &pos)
 	{
-		Block *blk = Blk;
-		for (;blk -> succ != nullptr;blk = blk -> succ);
-		nodeend.first = blk , nodeend.second = blk -> tail;
+		Block *blk = pos.first;
+		blk -> erase(pos.second) , resize_block(blk , -1) , -- total_size , ++ epoch , rebuild();
+		if (blk -> tot == 0 && (blk -> prec || blk -> succ)) unlink(blk) , reindex();
+		else if (merge(blk)) reindex();
 	}
+
 public:
 	class const_iterator;
 	class iterator {
@@ -188,13 +502,28 @@ public:
 		 * TODO add data members
 		 *   just add whatever you want.
 		 */
+		//idx is the logical index; loc caches its position and is trusted only while epoch matches cor -> epoch
 		const deque *cor;
-		pair<Block * , Node *> loc;
+		size_t idx;
+		mutable size_t epoch;
+		mutable pair<Block * , size_t> loc;
+
+		explicit iterator(const deque * const &cor_ , const size_t &idx_ , const pair<Block * , size_t> &loc_) : cor(cor_) , idx(idx_) , epoch(cor_ -> epoch) , loc(loc_) {}
+
+		//the position of idx, looked up again if the deque has been modified since it was cached
+		const pair<Block * , size_t> &where() const
+		{
+			if (epoch != cor -> epoch)
+			{
+				pair<Block * , size_t> loc_ = cor -> locate(idx);
+				loc.first = loc_.first , loc.second = loc_.second , epoch = cor -> epoch;
+			}
+			return loc;
+		}
 	public:
-		iterator() {}
-		explicit iterator(const deque * const &cor_ , const pair<Block * , Node *> &loc_) : cor(cor_) , loc(loc_) {}
-		iterator(const iterator &other) : cor(other.cor) , loc(other.loc) {}
-		iterator &operator=(const iterator &rhs) {cor = rhs.cor , loc.first = rhs.loc.first , loc.second = rhs.loc.second;return *this;}
+		iterator() : cor(nullptr) , idx(0) , epoch(0) {}
+		iterator(const iterator &other) : cor(other.cor) , idx(other.idx) , epoch(other.epoch) , loc(other.loc) {}
+		iterator &operator=(const iterator &rhs) {cor = rhs.cor , idx = rhs.idx , epoch = rhs.epoch , loc.first = rhs.loc.first , loc.second = rhs.loc.second;return *this;}
 		/**
 		 * return a new iterator which pointer n-next elements
 		 *   even if there are not enough elements, the behaviour is **undefined**.
@@ -203,64 +532,26 @@ public:
 		iterator operator+(const int &n) const
 		{
 			if (n < 0) return operator-(-n);
-			int n_ = n;
-			pair<Block * , Node *> loc_(loc);
-			for (;n_ && loc_.second -> succ;-- n_ , loc_.second = loc_.second -> succ);
-			if (n_)
-			{
-				-- n_;
-				if (loc_.first = loc_.first -> succ) loc_.second = loc_.first -> head;
-				else throw(invalid_iterator());
-			}
-			for (;n_ && n_ >= loc_.first -> tot;)
-			{
-				n_ -= loc_.first -> tot;
-				if (loc_.first = loc_.first -> succ) loc_.second = loc_.first -> head;
-				else throw(invalid_iterator());
-			}
-			for (;n_ && loc_.second -> succ;-- n_ , loc_.second = loc_.second -> succ);
-			return iterator(cor , loc_);
+			if (idx + n > cor -> total_size) throw(invalid_iterator());
+			const pair<Block * , size_t> &cur = where();
+			if (cur.second + n < cur.first -> tot) return iterator(cor , idx + n , pair<Block * , size_t>(cur.first , cur.second + n));
+			return iterator(cor , idx + n , cor -> locate(idx + n));
 		}
 
 		iterator operator-(const int &n) const
 		{
 			if (n < 0) return operator+(-n);
-			int n_ = n;
-			pair<Block * , Node *> loc_(loc);
-			for (;n_ && loc_.second -> prec;-- n_ , loc_.second = loc_.second -> prec);
-			if (n_)
-			{
-				-- n_;
-				if (loc_.first = loc_.first -> prec) loc_.second = loc_.first -> tail;
-				else throw(invalid_iterator());
-			}
-			for (;n_ && n_ >= loc_.first -> tot;)
-			{
-				n_ -= loc_.first -> tot;
-				if (loc_.first = loc_.first -> prec) loc_.second = loc_.first -> tail;
-				else throw(invalid_iterator());
-			}
-			for (;n_ && loc_.second -> prec;-- n_ , loc_.second = loc_.second -> prec);
-			return iterator(cor , loc_);
+			if (idx < (size_t)n) throw(invalid_iterator());
+			const pair<Block * , size_t> &cur = where();
+			if ((size_t)n <= cur.second) return iterator(cor , idx - n , pair<Block * , size_t>(cur.first , cur.second - n));
+			return iterator(cor , idx - n , cor -> locate(idx - n));
 		}
 		// return the distance between two iterator,
 		// if these two iterators points to different vectors, throw invaild_iterator.
 		int operator-(const iterator &rhs) const
 		{
 			if (cor != rhs.cor) throw(invalid_iterator());
-			int ret = 0;
-			pair<Block * , Node *> loc_(rhs.loc);
-			for (;loc_.second != loc.second && loc_.second -> succ;++ ret , loc_.second = loc_.second -> succ);
-			if (loc_.second != loc.second && loc_.first -> succ) ++ ret , loc_.first = loc_.first -> succ , loc_.second = loc_.first -> head;
-			for (;loc_.first != loc.first && loc_.first -> succ;ret += loc_.first -> tot , loc_.first = loc_.first -> succ , loc_.second = loc_.first -> head);
-			for (;loc_.second != loc.second && loc_.second -> succ;++ ret , loc_.second = loc_.second -> succ);
-			if (loc_.second == loc.second) return ret;
-			ret = 0 , loc_.first = rhs.loc.first , loc_.second = rhs.loc.second;
-			for (;loc_.second != loc.second && loc_.second -> prec;-- ret , loc_.second = loc_.second -> prec);
-			if (loc_.second != loc.second && loc_.first -> prec) -- ret , loc_.first = loc_.first -> prec , loc_.second = loc_.first -> tail;
-			for (;loc_.first != loc.first && loc_.first -> prec;ret -= loc_.first -> tot , loc_.first = loc_.first -> prec , loc_.second = loc_.first -> tail);
-			for (;loc_.second != loc.second && loc_.second -> prec;-- ret , loc_.second = loc_.second -> prec);
-			return ret;
+			return (int)idx - (int)rhs.idx;
 		}
 
 		iterator& operator+=(const int &n) {return (*this) = (*this) + n;}
@@ -272,48 +563,62 @@ public:
 		iterator operator++(int)
 		{
 			iterator ret = *this;
-			(*this) = (*this) + 1;
+			++ *this;
 			return ret;
 		}
 		/**
 		 * TODO ++iter
 		 */
-		iterator& operator++() {return (*this) = (*this) + 1;}
+		iterator& operator++()
+		{
+			//a step that stays inside a cached block needs no checks
+			if (epoch == cor -> epoch && loc.second + 1 < loc.first -> tot) return ++ idx , ++ loc.second , *this;
+			return (*this) = (*this) + 1;
+		}
 		/**
 		 * TODO iter--
 		 */
 		iterator operator--(int)
 		{
 			iterator ret = *this;
-			(*this) = (*this) - 1;
+			-- *this;
 			return ret;
 		}
 		/**
 		 * TODO --iter
 		 */
-		iterator& operator--() {return (*this) = (*this) - 1;}
+		iterator& operator--()
+		{
+			if (epoch == cor -> epoch && loc.second) return -- idx , -- loc.second , *this;
+			return (*this) = (*this) - 1;
+		}
 		/**
 		 * TODO *it
 		 */
 		T& operator*() const
 		{
-			if (loc.second -> value == nullptr) throw(invalid_iterator());
-			return *(loc.second -> value);
+			if (idx >= cor -> total_size) throw(invalid_iterator());
+			const pair<Block * , size_t> &cur = where();
+			return cur.first -> own() , (*cur.first)[cur.second];
 		}
 		/**
 		 * TODO it->field
 		 */
-		T* operator->() const noexcept {return loc.second -> value;}
+		T* operator->() const
+		{
+			const pair<Block * , size_t> &cur = where();
+			return cur.first -> own() , cur.first -> slot(cur.second);
+		}
 		/**
 		 * a operator to check whether two iterators are same (pointing to the same memory).
 		 */
-		bool operator==(const iterator &rhs) const {return loc.second == rhs.loc.second;}
-		bool operator==(const const_iterator &rhs) const {return loc.second == rhs.loc.second;}
+		bool operator==(const iterator &rhs) const {return cor == rhs.cor && idx == rhs.idx;}
+		bool operator==(const const_iterator &rhs) const {return cor == rhs.cor && idx == rhs.idx;}
 		/**
 		 * some other operator for iterator.
 		 */
-		bool operator!=(const iterator &rhs) const {return loc.second != rhs.loc.second;}
-		bool operator!=(const const_iterator &rhs) const {return loc.second != rhs.loc.second;}
+		bool operator!=(const iterator &rhs) const {return !(*this == rhs);}
+		bool operator!=(const const_iterator &rhs) const {return !(*this == rhs);}
 	};
 
 	class const_iterator {
@@ -324,13 +629,26 @@ public:
 	private:
 		// data members.
 		const deque *cor;
-		pair<const Block * , const Node *> loc;
+		size_t idx;
+		mutable size_t epoch;
+		mutable pair<const Block * , size_t> loc;
+
+		explicit const_iterator(const deque * const &cor_ , const size_t &idx_ , const pair<const Block * , size_t> &loc_) : cor(cor_) , idx(idx_) , epoch(cor_ -> epoch) , loc(loc_) {}
+
+		const pair<const Block * , size_t> &where() const
+		{
+			if (epoch != cor -> epoch)
+			{
+				pair<Block * , size_t> loc_ = cor -> locate(idx);
+				loc.first = loc_.first , loc.second = loc_.second , epoch = cor -> epoch;
+			}
+			return loc;
+		}
 	public:
-		const_iterator() {}
-		explicit const_iterator(const deque * const &cor_ , const pair<const Block * , const Node *> &loc_) : cor(cor_) , loc(loc_) {}
-		const_iterator(const const_iterator &other) : cor(other.cor) , loc(other.loc) {}
-		const_iterator(const iterator &other) : cor() , loc() {}
-		const_iterator &operator=(const const_iterator &rhs) {cor = rhs.cor , loc.first = rhs.loc.first , loc.second = rhs.loc.second;return *this;}
+		const_iterator() : cor(nullptr) , idx(0) , epoch(0) {}
+		const_iterator(const const_iterator &other) : cor(other.cor) , idx(other.idx) , epoch(other.epoch) , loc(other.loc) {}
+		const_iterator(const iterator &other) : cor(other.cor) , idx(other.idx) , epoch(other.epoch) , loc(other.loc.first , other.loc.second) {}
+		const_iterator &operator=(const const_iterator &rhs) {cor = rhs.cor , idx = rhs.idx , epoch = rhs.epoch , loc.first = rhs.loc.first , loc.second = rhs.loc.second;return *this;}
 		// And other methods in iterator.
 		/**
 		 * return a new iterator which pointer n-next elements
@@ -340,64 +658,26 @@ public:
 		const_iterator operator+(const int &n) const
 		{
 			if (n < 0) return operator-(-n);
-			int n_ = n;
-			pair<const Block * , const Node *> loc_(loc);
-			for (;n_ && loc_.second -> succ;-- n_ , loc_.second = loc_.second -> succ);
-			if (n_)
-			{
-				-- n_;
-				if (loc_.first = loc_.first -> succ) loc_.second = loc_.first -> head;
-				else throw(invalid_iterator());
-			}
-			for (;n_ && n_ >= loc_.first -> tot;)
-			{
-				n_ -= loc_.first -> tot;
-				if (loc_.first = loc_.first -> succ) loc_.second = loc_.first -> head;
-				else throw(invalid_iterator());
-			}
-			for (;n_ && loc_.second -> succ;-- n_ , loc_.second = loc_.second -> succ);
-			return const_iterator(cor , loc_);
+			if (idx + n > cor -> total_size) throw(invalid_iterator());
+			const pair<const Block * , size_t> &cur = where();
+			if (cur.second + n < cur.first -> tot) return const_iterator(cor , idx + n , pair<const Block * , size_t>(cur.first , cur.second + n));
+			return const_iterator(cor , idx + n , cor -> locate(idx + n));
 		}
 
 		const_iterator operator-(const int &n) const
 		{
 			if (n < 0) return operator+(-n);
-			int n_ = n;
-			pair<const Block * , const Node *> loc_(loc);
-			for (;n_ && loc_.second -> prec;-- n_ , loc_.second = loc_.second -> prec);
-			if (n_)
-			{
-				-- n_;
-				if (loc_.first = loc_.first -> prec) loc_.second = loc_.first -> tail;
-				else throw(invalid_iterator());
-			}
-			for (;n_ && n_ >= loc_.first -> tot;)
-			{
-				n_ -= loc_.first -> tot;
-				if (loc_.first = loc_.first -> prec) loc_.second = loc_.first -> tail;
-				else throw(invalid_iterator());
-			}
-			for (;n_ && loc_.second -> prec;-- n_ , loc_.second = loc_.second -> prec);
-			return const_iterator(cor , loc_);
+			if (idx < (size_t)n) throw(invalid_iterator());
+			const pair<const Block * , size_t> &cur = where();
+			if ((size_t)n <= cur.second) return const_iterator(cor , idx - n , pair<const Block * , size_t>(cur.first , cur.second - n));
+			return const_iterator(cor , idx - n , cor -> locate(idx - n));
 		}
 		// return the distance between two iterator,
 		// if these two iterators points to different vectors, throw invaild_iterator.
 		int operator-(const const_iterator &rhs) const
 		{
 			if (cor != rhs.cor) throw (invalid_iterator());
-			int ret = 0;
-			pair<const Block * , const Node *> loc_(rhs.loc);
-			for (;loc_.second != loc.second && loc_.second -> succ;++ ret , loc_.second = loc_.second -> succ);
-			if (loc_.second != loc.second && loc_.first -> succ) ++ ret , loc_.first = loc_.first -> succ , loc_.second = loc_.first -> head;
-			for (;loc_.first != loc.first && loc_.first -> succ;ret += loc_.first -> tot , loc_.first = loc_.first -> succ , loc_.second = loc_.first -> head);
-			for (;loc_.second != loc.second && loc_.second -> succ;++ ret , loc_.second = loc_.second -> succ);
-			if (loc_.second == loc.second) return ret;
-			ret = 0 , loc_.first = rhs.loc.first , loc_.second = rhs.loc.second;
-			for (;loc_.second != loc.second && loc_.second -> prec;-- ret , loc_.second = loc_.second -> prec);
-			if (loc_.second != loc.second && loc_.first -> prec) -- ret , loc_.first = loc_.first -> prec , loc_.second = loc_.first -> tail;
-			for (;loc_.first != loc.first && loc_.first -> prec;ret -= loc_.first -> tot , loc_.first = loc_.first -> prec , loc_.second = loc_.first -> tail);
-			for (;loc_.second != loc.second && loc_.second -> prec;-- ret , loc_.second = loc_.second -> prec);
-			return ret;
+			return (int)idx - (int)rhs.idx;
 		}
 
 		const_iterator& operator+=(const int &n) {return (*this) = (*this) + n;}
@@ -409,66 +689,93 @@ public:
 		const_iterator operator++(int)
 		{
 			const_iterator ret = *this;
-			(*this) = (*this) + 1;
+			++ *this;
 			return ret;
 		}
 		/**
 		 * TODO ++iter
 		 */
-		const_iterator& operator++() {return (*this) = (*this) + 1;}
+		const_iterator& operator++()
+		{
+			//a step that stays inside a cached block needs no checks
+			if (epoch == cor -> epoch && loc.second + 1 < loc.first -> tot) return ++ idx , ++ loc.second , *this;
+			return (*this) = (*this) + 1;
+		}
 		/**
 		 * TODO iter--
 		 */
 		const_iterator operator--(int)
 		{
 			const_iterator ret = *this;
-			(*this) = (*this) - 1;
+			-- *this;
 			return ret;
 		}
 		/**
 		 * TODO --iter
 		 */
-		const_iterator& operator--() {return (*this) = (*this) - 1;}
+		const_iterator& operator--()
+		{
+			if (epoch == cor -> epoch && loc.second) return -- idx , -- loc.second , *this;
+			return (*this) = (*this) - 1;
+		}
 		/**
 		 * TODO *it
 		 */
 		const T& operator*() const
 		{
-			if (loc.second -> value == nullptr) throw(invalid_iterator());
-			return *(loc.second -> value);
+			if (idx >= cor -> total_size) throw(invalid_iterator());
+			const pair<const Block * , size_t> &cur = where();
+			return (*cur.first)[cur.second];
 		}
 		/**
 		 * TODO it->field
 		 */
-		const T* operator->() const noexcept {return loc.second -> value;}
+		const T* operator->() const noexcept
+		{
+			const pair<const Block * , size_t> &cur = where();
+			return cur.first -> slot(cur.second);
+		}
 		/**
 		 * a operator to check whether two iterators are same (pointing to the same memory).
 		 */
-		bool operator==(const const_iterator &rhs) const {return loc.second == rhs.loc.second;}
-		bool operator==(const iterator &rhs) const {return loc.second == rhs.loc.second;}
+		bool operator==(const const_iterator &rhs) const {return cor == rhs.cor && idx == rhs.idx;}
+		bool operator==(const iterator &rhs) const {return cor == rhs.cor && idx == rhs.idx;}
 		/**
 		 * some other operator for iterator.
 		 */
-		bool operator!=(const const_iterator &rhs) const {return loc.second != rhs.loc.second;}
-		bool operator!=(const iterator &rhs) const {return loc.second != rhs.loc.second;}
+		bool operator!=(const const_iterator &rhs) const {return !(*this == rhs);}
+		bool operator!=(const iterator &rhs) const {return !(*this == rhs);}
 	};
 	/**
 	 * TODO Constructors
 	 */
-	deque() : total_size(1) , total_space(4) , block_size(2) , Blk(new Block(new Node)) , nodeend(Blk , Blk -> head) {}
+	deque() : total_size(0) , total_space(4) , block_size(2) , epoch(0) , Blk(Block::make(4)) , dir(nullptr) , fen(nullptr) , dir_space(0) , finger(nullptr) {reindex();}
 
-	deque(const deque &other) : total_size(other.total_size) , total_space(other.total_space) , block_size(other.block_size) , Blk(copy(other.Blk)) {findend();}
+	deque(const deque &other) : deque() {copy(other);}
+	/**
+	 * takes the blocks of other in O(1), leaving other empty.
+	 */
+	deque(deque &&other) : deque() {swap(other);}
 	/**
 	 * TODO Deconstructor
 	 */
-	~deque() {clear(Blk);}
+	~deque() {clear(Blk) , delete [] dir , delete [] fen;}
 	/**
 	 * TODO assignment operator
 	 */
 	deque &operator=(const deque &other)
 	{
 		if (&other == this) return *this;
-		clear(Blk) , Blk = copy(other.Blk) , total_size = other.total_size , total_space = other.total_space , block_size = other.block_size , findend();
+		clear() , copy(other);
+		return *this;
+	}
+	/**
+	 * takes the blocks of other in O(1) and frees the old elements, leaving other empty.
+	 */
+	deque &operator=(deque &&other)
+	{
+		if (&other == this) return *this;
+		swap(other) , other.clear();
 		return *this;
 	}
 	/**
@@ -477,22 +784,17 @@ public:
 	 */
 	const T & at(const size_t &pos) const
 	{
-		if (pos >= total_size - 1) throw(index_out_of_bound());
-		size_t cur = 0;
-		Block *blk;
-		if ((pos + 1 << 1) <= total_size) for (blk = Blk;cur + blk -> tot <= pos;cur += blk -> tot , blk = blk -> succ);
-		else
-		{
-			for (blk = nodeend.first , cur = total_size;cur - blk -> tot > pos;cur -= blk -> tot , blk = blk -> prec);
-			cur -= blk -> tot;
-		}
-		Node *node;
-		if ((pos - cur << 1) <= blk -> tot) for (node = blk -> head , ++ cur;cur <= pos;++ cur , node = node -> succ);
-		else for (node = blk -> tail , cur += blk -> tot - 2;cur >= pos;-- cur , node = node -> prec);
-		return *(node -> value);
+		if (pos >= total_size) throw(index_out_of_bound());
+		pair<Block * , size_t> loc = locate(pos);
+		return (*loc.first)[loc.second];
 	}
 
-	T & at(const size_t &pos) {return const_cast<T &>(static_cast<const deque &>(*this).at(pos));}
+	T & at(const size_t &pos)
+	{
+		if (pos >= total_size) throw(index_out_of_bound());
+		pair<Block * , size_t> loc = touch(pos);
+		return loc.first -> own() , (*loc.first)[loc.second];
+	}
 
 	T & operator[](const size_t &pos) {return at(pos);}
 	const T & operator[](const size_t &pos) const {return at(pos);}
@@ -502,44 +804,52 @@ public:
 	 */
 	const T & front() const
 	{
-		if (total_size == 1) throw(container_is_empty());
-		return *(Blk -> head -> value);
+		if (total_size == 0) throw(container_is_empty());
+		return (*Blk)[0];
 	}
 
-	T & front() {return const_cast<T &>(static_cast<const deque &>(*this).front());}
+	T & front()
+	{
+		if (total_size == 0) throw(container_is_empty());
+		return Blk -> own() , (*Blk)[0];
+	}
 	/**
 	 * access the last element
 	 * throw container_is_empty when the container is empty.
 	 */
 	const T & back() const
 	{
-		if (total_size == 1) throw(container_is_empty());
-		return *((nodeend.second -> prec ? nodeend.second -> prec : nodeend.first -> prec -> tail) -> value);
+		if (total_size == 0) throw(container_is_empty());
+		return (*blkend)[blkend -> tot - 1];
 	}
 
-	T & back() {return const_cast<T &>(static_cast<const deque &>(*this).back());}
+	T & back()
+	{
+		if (total_size == 0) throw(container_is_empty());
+		return blkend -> own() , (*blkend)[blkend -> tot - 1];
+	}
 	/**
 	 * returns an iterator to the beginning.
 	 */
-	iterator begin() {return iterator(this , pair<Block * , Node *>(Blk , Blk -> head));}
-	const_iterator cbegin() const {return const_iterator(this , pair<Block * , Node *>(Blk , Blk -> head));}
+	iterator begin() {return iterator(this , 0 , pair<Block * , size_t>(Blk , 0));}
+	const_iterator cbegin() const {return const_iterator(this , 0 , pair<const Block * , size_t>(Blk , 0));}
 	/**
 	 * returns an iterator to the end.
 	 */
-	iterator end() {return iterator(this , nodeend);}
-	const_iterator cend() const {return const_iterator(this , nodeend);}
+	iterator end() {return iterator(this , total_size , pair<Block * , size_t>(blkend , blkend -> tot));}
+	const_iterator cend() const {return const_iterator(this , total_size , pair<const Block * , size_t>(blkend , blkend -> tot));}
 	/**
 	 * checks whether the container is empty.
 	 */
-	bool empty() const {return cbegin() == cend();}
+	bool empty() const {return total_size == 0;}
 	/**
 	 * returns the number of elements
 	 */
-	size_t size() const {return total_size - 1;}
+	size_t size() const {return total_size;}
 	/**
 	 * clears the contents
 	 */
-	void clear() {clear(Blk) , total_size = 1 , total_space = 4 , block_size = 2 , Blk = new Block(new Node) , findend();}
+	void clear() {clear(Blk) , total_size = 0 , total_space = 4 , block_size = 2 , ++ epoch , Blk = Block::make(4) , reindex();}
 	/**
 	 * inserts elements at the specified locat on in the container.
 	 * inserts value before pos
@@ -548,8 +858,56 @@ public:
 	 */
 	iterator insert(iterator pos, const T &value)
 	{
-		if (pos.cor != this) throw(runtime_error());
-		return iterator(this , insert(pos.loc , value));
+		if (pos.cor != this || pos.idx > total_size) throw(runtime_error());
+		return iterator(this , pos.idx , insert(pos.where() , value));
+	}
+	iterator insert(iterator pos, T &&value)
+	{
+		if (pos.cor != this || pos.idx > total_size) throw(runtime_error());
+		return iterator(this , pos.idx , insert(pos.where() , std::move(value)));
+	}
+	/**
+	 * constructs an element from args before pos and returns an iterator pointing to it.
+	 * at either end it is built in place; in the middle it is built first and moved in, since
+	 * making room shifts elements that args may refer to.
+	 *     throw if the iterator is invalid or it point to a wrong place.
+	 */
+	template <class... Args>
+	iterator emplace(iterator pos, Args &&... args)
+	{
+		if (pos.cor != this || pos.idx > total_size) throw(runtime_error());
+		if (pos.idx == 0) emplace_front(std::forward<Args>(args)...);
+		else if (pos.idx == total_size) emplace_back(std::forward<Args>(args)...);
+		else return insert(pos , T (std::forward<Args>(args)...));
+		return iterator(this , pos.idx , locate(pos.idx));
+	}
+	/**
+	 * inserts n copies of value before pos, built as whole blocks and spliced in.
+	 * returns an iterator pointing to the first inserted value, or pos if n is 0.
+	 *     throw if the iterator is invalid or it point to a wrong place.
+	 */
+	iterator insert(iterator pos, const size_t &n, const T &value)
+	{
+		if (pos.cor != this || pos.idx > total_size) throw(runtime_error());
+		deque mid;
+		mid.build(&value , n , false) , insert(pos.idx , mid);
+		return iterator(this , pos.idx , locate(pos.idx));
+	}
+	/**
+	 * inserts copies of the elements in [first, last) before pos, built as whole blocks and spliced in.
+	 * the range is walked twice, once to count it, so it must be a forward range and must not be in this deque.
+	 * returns an iterator pointing to the first inserted value, or pos if the range is empty.
+	 *     throw if the iterator is invalid or it point to a wrong place.
+	 */
+	template <class ForwardIterator, class = typename std::enable_if<!std::is_integral<ForwardIterator>::value>::type>
+	iterator insert(iterator pos, ForwardIterator first, ForwardIterator last)
+	{
+		if (pos.cor != this || pos.idx > total_size) throw(runtime_error());
+		size_t n = 0;
+		for (ForwardIterator it = first;it != last;++ it) ++ n;
+		deque mid;
+		mid.build(first , n , true) , insert(pos.idx , mid);
+		return iterator(this , pos.idx , locate(pos.idx));
 	}
 	/**
 	 * removes specified element at pos.
@@ -559,29 +917,196 @@ public:
 	 */
 	iterator erase(iterator pos)
 	{
-		if (pos.cor != this || pos == end()) throw(runtime_error());
-		return iterator(this , erase(pos.loc));
+		if (pos.cor != this || pos.idx >= total_size) throw(runtime_error());
+		erase(pos.where());
+		return iterator(this , pos.idx , locate(pos.idx));
+	}
+	/**
+	 * removes the elements in [first, last): the blocks in between are cut out and freed whole.
+	 * returns an iterator pointing to the element that followed them.
+	 * throw if the iterators are invalid, out of order or point to a wrong place.
+	 */
+	iterator erase(iterator first, iterator last)
+	{
+		if (first.cor != this || last.cor != this || first.idx > last.idx || last.idx > total_size) throw(runtime_error());
+		if (first.idx == last.idx) return iterator(this , first.idx , locate(first.idx));
+		deque tail = split_at(last.idx);
+		split_at(first.idx) , append(std::move(tail));
+		return iterator(this , first.idx , locate(first.idx));
 	}
 	/**
 	 * adds an element to the end
 	 */
-	void push_back(const T &value) {insert(end() , value);}
+	void push_back(const T &value) {emplace_back(value);}
+	void push_back(T &&value) {emplace_back(std::move(value));}
+	/**
+	 * constructs an element from args in place at the end; nothing already stored is moved.
+	 */
+	template <class... Args>
+	void emplace_back(Args &&... args)
+	{
+		Block *blk = blkend -> tot < blkend -> cap ? blkend : maintain(pair<Block * , size_t>(blkend , blkend -> tot)).first;
+		blk -> insert(blk -> tot , std::forward<Args>(args)...) , ++ back_lag , ++ total_size , ++ epoch , rebuild();
+	}
 	/**
 	 * removes the last element
 	 *     throw when the container is empty.
 	 */
-	void pop_back() {erase(end() - 1);}
+	void pop_back()
+	{
+		if (total_size == 0) throw(container_is_empty());
+		pop(blkend , blkend -> tot - 1);
+	}
 	/**
 	 * inserts an element to the beginning.
 	 */
-	void push_front(const T &value) {insert(begin() , value);}
+	void push_front(const T &value) {emplace_front(value);}
+	void push_front(T &&value) {emplace_front(std::move(value));}
+	/**
+	 * constructs an element from args in place at the beginning; nothing already stored is moved.
+	 */
+	template <class... Args>
+	void emplace_front(Args &&... args)
+	{
+		Block *blk = Blk -> tot < Blk -> cap ? Blk : maintain(pair<Block * , size_t>(Blk , 0)).first;
+		blk -> insert(0 , std::forward<Args>(args)...) , ++ front_lag , ++ total_size , ++ epoch , rebuild();
+	}
 	/**
 	 * removes the first element.
 	 *     throw when the container is empty.
 	 */
-	void pop_front() {erase(begin());}
+	void pop_front()
+	{
+		if (total_size == 0) throw(container_is_empty());
+		pop(Blk , 0);
+	}
+	/**
+	 * moves the elements from index on into a new deque, which is returned; this deque keeps the first index.
+	 * whole blocks are handed over, only the block holding index is cut in two.
+	 * throw index_out_of_bound if index > size().
+	 */
+	deque split_at(const size_t &index)
+	{
+		if (index > total_size) throw(index_out_of_bound());
+		deque ret;
+		if (index == total_size) return ret;
+		pair<Block * , size_t> pos = locate(index);
+		Block *blk = pos.first;
+		if (pos.second)//the shorter part of blk is moved to a new block
+		{
+			Block *nblk = Block::make(blk -> cap);
+			blk -> own();
+			if (pos.second < blk -> tot - pos.second)
+			{
+				relocated(pos.second);
+				for (size_t i = 0;i < pos.second;++ i) relocate(nblk -> slot(nblk -> tot ++) , blk -> slot(i));
+				blk -> head = blk -> slot(pos.second) - blk -> data() , blk -> tot -= pos.second;
+				if (nblk -> prec = blk -> prec) nblk -> prec -> succ = nblk;
+				else Blk = nblk;
+				(blk -> prec = nblk) -> succ = blk;
+			}
+			else
+			{
+				relocated(blk -> tot - pos.second);
+				for (size_t i = pos.second;i < blk -> tot;++ i) relocate(nblk -> slot(nblk -> tot ++) , blk -> slot(i));
+				blk -> tot = pos.second;
+				if (nblk -> succ = blk -> succ) nblk -> succ -> prec = nblk;
+				else blkend = nblk;
+				(blk -> succ = nblk) -> prec = blk;
+				blk = nblk;
+			}
+		}
+		delete ret.Blk , ret.Blk = blk;
+		if (blk -> prec) blk -> prec -> succ = nullptr , blk -> prec = nullptr;
+		else Blk = Block::make(4);
+		ret.total_size = total_size - index , total_size = index;
+		ret.rebuild() , ret.reindex() , rebuild() , ++ epoch , reindex();
+		return ret;
+	}
+	/**
+	 * moves all elements of other to the end of this deque, leaving other empty. no element is copied:
+	 * the blocks of other are linked in and indexed one by one, and only the two blocks at the seam
+	 * are merged when either is underfull.
+	 * throw runtime_error if other is this deque.
+	 */
+	void append(deque &&other)
+	{
+		if (&other == this) throw(runtime_error());
+		if (!other.total_size) return;
+		if (!total_size) return swap(other);
+		size_t n = other.total_size , k = 0;
+		flush() , seam(other);
+		for (Block *blk = other.Blk;blk;blk = blk -> succ) ++ k;
+		if (k) (blkend -> succ = other.Blk) -> prec = blkend;
+		if (base + cnt + k > dir_space) reindex();
+		else for (Block *blk = other.Blk;blk;blk = blk -> succ) blk -> id = base + cnt ++ , dir[blk -> id] = blk , resize_block(blk , blk -> tot) , blkend = blk;
+		total_size += n , rebuild() , ++ epoch;
+		if (cnt > (total_size / block_size + 2) << 2) repack();
+		other.Blk = nullptr , other.clear();
+	}
+	/**
+	 * moves all elements of other before pos, leaving other empty, by cutting this deque at pos and
+	 * relinking the blocks.
+	 * throw if pos is not an iterator of this deque or other is this deque.
+	 */
+	void splice(iterator pos, deque &other)
+	{
+		if (pos.cor != this || pos.idx > total_size || &other == this) throw(runtime_error());
+		deque tail = split_at(pos.idx);
+		append(std::move(other)) , append(std::move(tail));
+	}
+	/**
+	 * returns a copy of this deque in O(number of blocks). the copy shares its blocks with this deque;
+	 * whichever of the two first writes to a shared block clones that block alone, in O(block_size).
+	 * writes include modifications as well as taking a non-const reference, iterator dereference or
+	 * segment; a reference taken before the snapshot must not be written through after it.
+	 * the snapshot may be read and destroyed by another thread while this deque is being modified.
+	 */
+	deque snapshot() const
+	{
+		static_assert(std::is_copy_constructible<T>::value , "a shared block is cloned on its first write");
+		deque ret;
+		ret.share(*this);
+		return ret;
+	}
+	/**
+	 * calls f(T *first, T *last) on every run of elements that lie contiguously in memory, front to
+	 * back; a block gives one run, or two where its ring buffer wraps around. loops over a run need no
+	 * block boundary checks. f may modify the elements but must not insert or erase.
+	 */
+	template <class Function>
+	void for_each_segment(Function f) {segments<T *>(0 , total_size , f);}
+	/**
+	 * the same as for_each_segment(f), with f(const T *first, const T *last).
+	 */
+	template <class Function>
+	void for_each_segment(Function f) const {segments<const T *>(0 , total_size , f);}
+	/**
+	 * for_each_segment restricted to [first, last).
+	 * throw invalid_iterator if the iterators belong to another deque or first is after last.
+	 */
+	template <class Function>
+	void for_each_segment(const const_iterator &first , const const_iterator &last , Function f) const
+	{
+		if (first.cor != this || last.cor != this || first.idx > last.idx) throw(invalid_iterator());
+		segments<const T *>(first.idx , last.idx - first.idx , f);
+	}
+	template <class Function>
+	void for_each_segment(const iterator &first , const iterator &last , Function f)
+	{
+		if (first.cor != this || last.cor != this || first.idx > last.idx) throw(invalid_iterator());
+		segments<T *>(first.idx , last.idx - first.idx , f);
+	}
+	/**
+	 * the number of elements moved between slots by all deques of this type so far,
+	 * when a block is shifted or split. every other copy of T is one the caller asked for.
+	 */
+	static size_t relocation_count() {return relocations.load(std::memory_order_relaxed);}
 };
 
+template <class T>
+std::atomic<size_t> deque<T>::relocations(0);
+
 }
 
-#endif
\ No newline at end of file
+#endif
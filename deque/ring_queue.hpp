@@ -0,0 +1,266 @@
+#ifndef SJTU_RING_QUEUE_HPP
+#define SJTU_RING_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+
+namespace sjtu
+{
+namespace ring_detail
+{
+	//spin a while, then give the cpu away; used by the blocking push and pop
+	inline void backoff(size_t &round)
+	{
+		if (++ round < 64) return;
+		std::this_thread::yield();
+	}
+
+	inline size_t round_up(const size_t &capacity)
+	{
+		size_t cap = 2;
+		for (;cap < capacity;cap <<= 1);
+		return cap;
+	}
+}
+
+/**
+ * a bounded lock-free queue for exactly one producer thread and one consumer thread.
+ * head is written only by the consumer and tail only by the producer; each lives on its own
+ * cache line next to the side's cached copy of the other index, so the other line is read only
+ * when the cached copy says the ring looks full (or empty).
+ * try_ operations fail instead of waiting; push and pop spin, then yield, until they succeed.
+ */
+template <class T>
+class spsc_queue
+{
+private:
+	struct Slot {alignas(T) unsigned char data[sizeof(T)];};
+
+	const size_t cap;
+	Slot *ring;
+	alignas(64) std::atomic<size_t> head;
+	size_t tail_seen;//the consumer's copy of tail
+	alignas(64) std::atomic<size_t> tail;
+	size_t head_seen;//the producer's copy of head
+
+	T *at(const size_t &i) const {return reinterpret_cast<T *>(ring[i & (cap - 1)].data);}
+	//free slots from the producer's side, reloading head only if the cached copy is short of n
+	size_t room(const size_t &t , const size_t &n)
+	{
+		if (cap - (t - head_seen) < n) head_seen = head.load(std::memory_order_acquire);
+		return cap - (t - head_seen);
+	}
+	size_t ready(const size_t &h , const size_t &n)
+	{
+		if (tail_seen - h < n) tail_seen = tail.load(std::memory_order_acquire);
+		return tail_seen - h;
+	}
+public:
+	/**
+	 * capacity is rounded up to a power of two.
+	 */
+	explicit spsc_queue(size_t capacity = 1024) : cap(ring_detail::round_up(capacity)) , ring(new Slot [cap]) , head(0) , tail_seen(0) , tail(0) , head_seen(0) {}
+	spsc_queue(const spsc_queue &) = delete;
+	spsc_queue &operator=(const spsc_queue &) = delete;
+	~spsc_queue()
+	{
+		for (size_t h = head.load() , t = tail.load();h != t;++ h) at(h) -> ~T();
+		delete [] ring;
+	}
+	/**
+	 * producer only.
+	 * @return false if the queue is full.
+	 */
+	bool try_push(const T &value) {
+		size_t t = tail.load(std::memory_order_relaxed);
+		if (!room(t , 1)) return false;
+		new (at(t)) T(value);
+		tail.store(t + 1 , std::memory_order_release);
+		return true;
+	}
+	/**
+	 * producer only: push the longest prefix of [first, first + n) that fits, publishing it at once.
+	 * @return the number of elements pushed.
+	 */
+	size_t try_push(const T *first , size_t n) {
+		size_t t = tail.load(std::memory_order_relaxed) , free = room(t , n);
+		if (n > free) n = free;
+		for (size_t i = 0;i < n;++ i) new (at(t + i)) T(first[i]);
+		tail.store(t + n , std::memory_order_release);
+		return n;
+	}
+	/**
+	 * consumer only.
+	 * @return false if the queue is empty.
+	 */
+	bool try_pop(T &out) {
+		size_t h = head.load(std::memory_order_relaxed);
+		if (!ready(h , 1)) return false;
+		T *p = at(h);
+		out = *p , p -> ~T();
+		head.store(h + 1 , std::memory_order_release);
+		return true;
+	}
+	/**
+	 * consumer only: pop up to n elements into out.
+	 * @return the number of elements popped.
+	 */
+	size_t try_pop(T *out , size_t n) {
+		size_t h = head.load(std::memory_order_relaxed) , cnt = ready(h , n);
+		if (n > cnt) n = cnt;
+		for (size_t i = 0;i < n;++ i)
+		{
+			T *p = at(h + i);
+			out[i] = *p , p -> ~T();
+		}
+		head.store(h + n , std::memory_order_release);
+		return n;
+	}
+	/**
+	 * producer only: wait until there is room for value.
+	 */
+	void push(const T &value) {
+		for (size_t round = 0;!try_push(value);) ring_detail::backoff(round);
+	}
+	/**
+	 * consumer only: wait for an element.
+	 */
+	void pop(T &out) {
+		for (size_t round = 0;!try_pop(out);) ring_detail::backoff(round);
+	}
+	/**
+	 * a snapshot; exact only when neither side is working on the queue.
+	 */
+	size_t size() const {
+		size_t h = head.load(std::memory_order_acquire);
+		return tail.load(std::memory_order_acquire) - h;
+	}
+	bool empty() const {return !size();}
+	size_t capacity() const {return cap;}
+};
+
+/**
+ * a bounded lock-free queue for any number of producers and consumers (Vyukov's design).
+ * every slot carries a sequence number telling which lap of which side may use it next; a
+ * thread claims slots by moving head or tail with a compare-and-swap, so one slot never has
+ * two users. a batch claims a run of slots with a single compare-and-swap.
+ * try_ operations fail instead of waiting; push and pop spin, then yield, until they succeed.
+ */
+template <class T>
+class mpmc_queue
+{
+private:
+	struct Slot
+	{
+		std::atomic<size_t> seq;
+		alignas(T) unsigned char data[sizeof(T)];
+	};
+
+	const size_t cap;
+	Slot *ring;
+	alignas(64) std::atomic<size_t> head;
+	alignas(64) std::atomic<size_t> tail;
+
+	T *at(const size_t &i) const {return reinterpret_cast<T *>(ring[i & (cap - 1)].data);}
+
+	/*
+	 * claim up to n slots at the end named by pos: slot pos + i is free for this side when its
+	 * sequence equals pos + i + lag (lag is 0 for producers, 1 for consumers).
+	 * returns the first claimed position and sets n to the number claimed, possibly 0.
+	 */
+	size_t claim(std::atomic<size_t> &pos , size_t &n , const size_t &lag)
+	{
+		for (size_t p = pos.load(std::memory_order_relaxed);;)
+		{
+			size_t k = 0;
+			for (;k < n && ring[(p + k) & (cap - 1)].seq.load(std::memory_order_acquire) == p + k + lag;++ k);
+			if (!k)
+			{
+				size_t now = pos.load(std::memory_order_relaxed);
+				//the slot is still held by the other side of the previous lap: full or empty
+				if (now == p) return n = 0 , p;
+				p = now;
+				continue;
+			}
+			if (pos.compare_exchange_weak(p , p + k , std::memory_order_relaxed)) return n = k , p;
+		}
+	}
+public:
+	/**
+	 * capacity is rounded up to a power of two.
+	 */
+	explicit mpmc_queue(size_t capacity = 1024) : cap(ring_detail::round_up(capacity)) , ring(new Slot [cap]) , head(0) , tail(0)
+	{
+		for (size_t i = 0;i < cap;++ i) ring[i].seq.store(i , std::memory_order_relaxed);
+	}
+	mpmc_queue(const mpmc_queue &) = delete;
+	mpmc_queue &operator=(const mpmc_queue &) = delete;
+	~mpmc_queue()
+	{
+		for (size_t h = head.load() , t = tail.load();h != t;++ h) at(h) -> ~T();
+		delete [] ring;
+	}
+	/**
+	 * @return false if the queue is full.
+	 */
+	bool try_push(const T &value) {return try_push(&value , 1);}
+	/**
+	 * push a prefix of [first, first + n); the pushed elements are consecutive in the queue.
+	 * @return the number of elements pushed.
+	 */
+	size_t try_push(const T *first , size_t n) {
+		size_t p = claim(tail , n , 0);
+		for (size_t i = 0;i < n;++ i)
+		{
+			new (at(p + i)) T(first[i]);
+			ring[(p + i) & (cap - 1)].seq.store(p + i + 1 , std::memory_order_release);
+		}
+		return n;
+	}
+	/**
+	 * @return false if the queue is empty.
+	 */
+	bool try_pop(T &out) {return try_pop(&out , 1);}
+	/**
+	 * pop up to n consecutive elements into out.
+	 * @return the number of elements popped.
+	 */
+	size_t try_pop(T *out , size_t n) {
+		size_t p = claim(head , n , 1);
+		for (size_t i = 0;i < n;++ i)
+		{
+			T *e = at(p + i);
+			out[i] = *e , e -> ~T();
+			ring[(p + i) & (cap - 1)].seq.store(p + i + cap , std::memory_order_release);
+		}
+		return n;
+	}
+	/**
+	 * wait until there is room for value.
+	 */
+	void push(const T &value) {
+		for (size_t round = 0;!try_push(value);) ring_detail::backoff(round);
+	}
+	/**
+	 * wait for an element.
+	 */
+	void pop(T &out) {
+		for (size_t round = 0;!try_pop(out);) ring_detail::backoff(round);
+	}
+	/**
+	 * a snapshot of the number of claimed-but-unpopped slots; exact only when no thread is working
+	 * on the queue.
+	 */
+	size_t size() const {
+		size_t h = head.load(std::memory_order_acquire) , t = tail.load(std::memory_order_acquire);
+		return t > h ? t - h : 0;
+	}
+	bool empty() const {return !size();}
+	size_t capacity() const {return cap;}
+};
+
+}
+
+#endif
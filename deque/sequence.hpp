@@ -0,0 +1,531 @@
+#ifndef SJTU_SEQUENCE_HPP
+#define SJTU_SEQUENCE_HPP
+
+#include "exceptions.hpp"
+#include "utility.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <utility>
+
+namespace sjtu
+{
+/**
+ * a sequence with the interface of deque, stored as an implicit treap over chunks of up to
+ * chunk contiguous elements. each node is one chunk, ordered in the tree by position and
+ * heap-ordered by a random priority, so at, insert, erase, split_at and append all take
+ * O(log n) expected time (plus O(chunk) to shift inside one chunk), and scans run over
+ * whole chunks.
+ */
+template <class T>
+class sequence
+{
+private:
+	static const size_t chunk = 2048 / sizeof(T) > 16 ? 2048 / sizeof(T) : 16;
+
+	struct Node
+	{
+		size_t tot , sum;//sum counts the elements in the subtree
+		unsigned pri;
+		Node *ls , *rs;
+		alignas(T) unsigned char storage[chunk * sizeof(T)];//the chunk, inline in the node
+
+		explicit Node(const unsigned &pri_) : tot(0) , sum(0) , pri(pri_) , ls(nullptr) , rs(nullptr) {}
+		Node(const Node &other) : Node(other.pri)
+		{
+			for (;tot < other.tot;++ tot) new (data() + tot) T (other.data()[tot]);
+			sum = other.sum;
+		}
+		Node &operator=(const Node &other) = delete;
+		~Node()
+		{
+			for (size_t i = 0;i < tot;++ i) data()[i].~T();
+		}
+
+		T *data() const {return reinterpret_cast<T *>(const_cast<unsigned char *>(storage));}
+		//whether p points into the chunk
+		bool holds(const T *p) const {return !std::less<const T *>()(p , data()) && std::less<const T *>()(p , data() + chunk);}
+	}*root;
+
+	size_t epoch;//bumped by every modification, so iterators know when their cached position is stale
+	unsigned seed;
+
+	unsigned random() {return seed ^= seed << 13 , seed ^= seed >> 17 , seed ^= seed << 5;}
+
+	static size_t sum(const Node *t) {return t ? t -> sum : 0;}
+
+	static void pull(Node *t) {t -> sum = sum(t -> ls) + t -> tot + sum(t -> rs);}
+
+	static void relocate(T *dst , T *src) {new (dst) T (std::move(*src)) , src -> ~T();}
+
+	static Node *rotate_left(Node *t)
+	{
+		Node *r = t -> rs;
+		t -> rs = r -> ls , r -> ls = t , pull(t) , pull(r);
+		return r;
+	}
+
+	static Node *rotate_right(Node *t)
+	{
+		Node *l = t -> ls;
+		t -> ls = l -> rs , l -> rs = t , pull(t) , pull(l);
+		return l;
+	}
+
+	static Node *merge(Node *a , Node *b)
+	{
+		if (!a) return b;
+		if (!b) return a;
+		if (a -> pri > b -> pri) return a -> rs = merge(a -> rs , b) , pull(a) , a;
+		return b -> ls = merge(a , b -> ls) , pull(b) , b;
+	}
+
+	//splits t into its first k elements and the rest, cutting at most one chunk
+	void split(Node *t , size_t k , Node *&a , Node *&b)
+	{
+		if (!t) {a = b = nullptr;return;}
+		size_t l = sum(t -> ls);
+		if (k <= l) split(t -> ls , k , a , t -> ls) , pull(t) , b = t;
+		else if (k >= l + t -> tot) split(t -> rs , k - l - t -> tot , t -> rs , b) , pull(t) , a = t;
+		else
+		{
+			Node *n = new Node (random()) , *r = t -> rs;
+			for (size_t i = k - l;i < t -> tot;++ i) relocate(n -> data() + n -> tot ++ , t -> data() + i);
+			t -> tot = k - l , t -> rs = nullptr , pull(t) , pull(n) , a = t , b = merge(n , r);
+		}
+	}
+
+	//puts n, a single node, before everything in t
+	static Node *push_front(Node *t , Node *n)
+	{
+		if (!t) return pull(n) , n;
+		if (n -> pri > t -> pri) return n -> rs = t , pull(n) , n;
+		return t -> ls = push_front(t -> ls , n) , pull(t) , t;
+	}
+
+	//removes the first node of t, which must not be empty, into n
+	static Node *pop_front(Node *t , Node *&n)
+	{
+		if (!t -> ls) return n = t , t = t -> rs , n -> rs = nullptr , pull(n) , t;
+		return t -> ls = pop_front(t -> ls , n) , pull(t) , t;
+	}
+
+	//removes the last node of t, which must not be empty, into n
+	static Node *pop_back(Node *t , Node *&n)
+	{
+		if (!t -> rs) return n = t , t = t -> ls , n -> ls = nullptr , pull(n) , t;
+		return t -> rs = pop_back(t -> rs , n) , pull(t) , t;
+	}
+
+	//moves the elements of n to the end of the last chunk of t, which has room for them
+	static void absorb(Node *t , Node *n)
+	{
+		if (t -> rs) absorb(t -> rs , n);
+		else for (size_t j = 0;j < n -> tot;++ j) relocate(t -> data() + t -> tot ++ , n -> data() + j);
+		pull(t);
+	}
+
+	//merges a and b; when one of the two chunks at the seam is less than half full and both fit
+	//in one chunk, the first chunk of b is moved into the last chunk of a
+	static Node *join(Node *a , Node *b)
+	{
+		if (!a || !b) return a ? a : b;
+		Node *n , *t = a;
+		for (;t -> rs;t = t -> rs);
+		b = pop_front(b , n);
+		if ((t -> tot >= chunk >> 1 && n -> tot >= chunk >> 1) || t -> tot + n -> tot > chunk) return merge(a , merge(n , b));
+		absorb(a , n) , n -> tot = 0 , delete n;
+		return merge(a , b);
+	}
+
+	Node *insert(Node *t , size_t i , const T &value)
+	{
+		if (!t)
+		{
+			Node *n = new Node (random());
+			return new (n -> data()) T (value) , n -> tot = n -> sum = 1 , n;
+		}
+		size_t l = sum(t -> ls);
+		if (i < l)
+		{
+			t -> ls = insert(t -> ls , i , value) , pull(t);
+			return t -> ls -> pri > t -> pri ? rotate_right(t) : t;
+		}
+		if (i > l + t -> tot)
+		{
+			t -> rs = insert(t -> rs , i - l - t -> tot , value) , pull(t);
+			return t -> rs -> pri > t -> pri ? rotate_left(t) : t;
+		}
+		if (t -> holds(&value))//the split or the shift would move value before it is read
+		{
+			T tmp(value);
+			return insert(t , i , tmp);
+		}
+		i -= l;
+		Node *n = t;
+		if (t -> tot == chunk)//the upper half moves to a new chunk right after this one
+		{
+			Node *m = new Node (random());
+			for (size_t j = chunk >> 1;j < chunk;++ j) relocate(m -> data() + m -> tot ++ , t -> data() + j);
+			t -> tot = chunk >> 1;
+			if (i > t -> tot) n = m , i -= t -> tot;
+			for (size_t j = n -> tot;j > i;-- j) relocate(n -> data() + j , n -> data() + j - 1);
+			new (n -> data() + i) T (value) , ++ n -> tot;
+			t -> rs = push_front(t -> rs , m) , pull(t);
+			return t -> rs -> pri > t -> pri ? rotate_left(t) : t;
+		}
+		for (size_t j = n -> tot;j > i;-- j) relocate(n -> data() + j , n -> data() + j - 1);
+		new (n -> data() + i) T (value) , ++ n -> tot , pull(t);
+		return t;
+	}
+
+	//inserts value before index i of the sequence. a full chunk at either end gets a new chunk merged in
+	//next to it instead of being split, so pushes at the ends leave full chunks behind
+	void insert(const size_t &i , const T &value)
+	{
+		Node *t = root;
+		bool edge = t && (!i || i == t -> sum);
+		for (;edge && (i ? t -> rs : t -> ls);) t = i ? t -> rs : t -> ls;
+		if (edge && t -> tot == chunk)
+		{
+			Node *n = new Node (random());
+			new (n -> data()) T (value) , n -> tot = n -> sum = 1;
+			root = i ? merge(root , n) : merge(n , root);
+		}
+		else root = insert(root , i , value);
+		++ epoch;
+	}
+
+	Node *erase(Node *t , size_t i)
+	{
+		size_t l = sum(t -> ls);
+		if (i < l) return t -> ls = erase(t -> ls , i) , pull(t) , t;
+		if (i >= l + t -> tot) return t -> rs = erase(t -> rs , i - l - t -> tot) , pull(t) , t;
+		i -= l , t -> data()[i].~T();
+		for (;i + 1 < t -> tot;++ i) relocate(t -> data() + i , t -> data() + i + 1);
+		-- t -> tot;
+		if (!t -> tot)
+		{
+			Node *ret = merge(t -> ls , t -> rs);
+			t -> ls = t -> rs = nullptr , delete t;
+			return ret;
+		}
+		if (t -> tot < chunk >> 2 && t -> rs)//a small chunk takes in its successor if that one fits
+		{
+			Node *n = t -> rs;
+			for (;n -> ls;n = n -> ls);
+			if (t -> tot + n -> tot <= chunk)
+			{
+				t -> rs = pop_front(t -> rs , n);
+				for (size_t j = 0;j < n -> tot;++ j) relocate(t -> data() + t -> tot ++ , n -> data() + j);
+				n -> tot = 0 , delete n;
+			}
+		}
+		return pull(t) , t;
+	}
+
+	//the node holding index pos and the offset in it, (nullptr, 0) if pos == size()
+	pair<Node * , size_t> locate(size_t pos) const
+	{
+		for (Node *t = root;t;)
+		{
+			size_t l = sum(t -> ls);
+			if (pos < l) t = t -> ls;
+			else if (pos < l + t -> tot) return pair<Node * , size_t>(t , pos - l);
+			else pos -= l + t -> tot , t = t -> rs;
+		}
+		return pair<Node * , size_t>(nullptr , 0);
+	}
+
+	static Node *copy(const Node *t)
+	{
+		if (!t) return nullptr;
+		Node *ret = new Node (*t);
+		ret -> ls = copy(t -> ls) , ret -> rs = copy(t -> rs);
+		return ret;
+	}
+
+	static void clear(Node *t)
+	{
+		if (!t) return;
+		clear(t -> ls) , clear(t -> rs) , delete t;
+	}
+public:
+	class const_iterator;
+	class iterator {
+		friend class sequence;
+		friend class const_iterator;
+	private:
+		//idx is the logical index; loc caches its position and is trusted only while epoch matches cor -> epoch
+		const sequence *cor;
+		size_t idx;
+		mutable size_t epoch;
+		mutable pair<Node * , size_t> loc;
+
+		explicit iterator(const sequence * const &cor_ , const size_t &idx_) : cor(cor_) , idx(idx_) , epoch(cor_ -> epoch - 1) {}
+		explicit iterator(const sequence * const &cor_ , const size_t &idx_ , const pair<Node * , size_t> &loc_) : cor(cor_) , idx(idx_) , epoch(cor_ -> epoch) , loc(loc_) {}
+
+		const pair<Node * , size_t> &where() const
+		{
+			if (epoch != cor -> epoch)
+			{
+				pair<Node * , size_t> loc_ = cor -> locate(idx);
+				loc.first = loc_.first , loc.second = loc_.second , epoch = cor -> epoch;
+			}
+			return loc;
+		}
+	public:
+		iterator() : cor(nullptr) , idx(0) , epoch(0) {}
+		iterator(const iterator &other) : cor(other.cor) , idx(other.idx) , epoch(other.epoch) , loc(other.loc) {}
+		iterator &operator=(const iterator &rhs) {cor = rhs.cor , idx = rhs.idx , epoch = rhs.epoch , loc.first = rhs.loc.first , loc.second = rhs.loc.second;return *this;}
+		/**
+		 * return a new iterator which points n elements further; throw invalid_iterator past either end.
+		 */
+		iterator operator+(const int &n) const
+		{
+			if (n < 0) return operator-(-n);
+			if (idx + n > cor -> size()) throw(invalid_iterator());
+			const pair<Node * , size_t> &cur = where();
+			if (cur.first && cur.second + n < cur.first -> tot) return iterator(cor , idx + n , pair<Node * , size_t>(cur.first , cur.second + n));
+			return iterator(cor , idx + n);
+		}
+		iterator operator-(const int &n) const
+		{
+			if (n < 0) return operator+(-n);
+			if (idx < (size_t)n) throw(invalid_iterator());
+			const pair<Node * , size_t> &cur = where();
+			if (cur.first && (size_t)n <= cur.second) return iterator(cor , idx - n , pair<Node * , size_t>(cur.first , cur.second - n));
+			return iterator(cor , idx - n);
+		}
+		// return the distance between two iterator,
+		// if these two iterators points to different sequences, throw invaild_iterator.
+		int operator-(const iterator &rhs) const
+		{
+			if (cor != rhs.cor) throw(invalid_iterator());
+			return (int)idx - (int)rhs.idx;
+		}
+		iterator& operator+=(const int &n) {return (*this) = (*this) + n;}
+		iterator& operator-=(const int &n) {return (*this) = (*this) - n;}
+		iterator operator++(int)
+		{
+			iterator ret = *this;
+			(*this) = (*this) + 1;
+			return ret;
+		}
+		iterator& operator++() {return (*this) = (*this) + 1;}
+		iterator operator--(int)
+		{
+			iterator ret = *this;
+			(*this) = (*this) - 1;
+			return ret;
+		}
+		iterator& operator--() {return (*this) = (*this) - 1;}
+		T& operator*() const
+		{
+			if (idx >= cor -> size()) throw(invalid_iterator());
+			const pair<Node * , size_t> &cur = where();
+			return cur.first -> data()[cur.second];
+		}
+		T* operator->() const noexcept
+		{
+			const pair<Node * , size_t> &cur = where();
+			return cur.first -> data() + cur.second;
+		}
+		bool operator==(const iterator &rhs) const {return cor == rhs.cor && idx == rhs.idx;}
+		bool operator==(const const_iterator &rhs) const {return cor == rhs.cor && idx == rhs.idx;}
+		bool operator!=(const iterator &rhs) const {return !(*this == rhs);}
+		bool operator!=(const const_iterator &rhs) const {return !(*this == rhs);}
+	};
+
+	class const_iterator {
+		friend class sequence;
+		friend class iterator;
+	private:
+		const sequence *cor;
+		size_t idx;
+		mutable size_t epoch;
+		mutable pair<const Node * , size_t> loc;
+
+		explicit const_iterator(const sequence * const &cor_ , const size_t &idx_) : cor(cor_) , idx(idx_) , epoch(cor_ -> epoch - 1) {}
+		explicit const_iterator(const sequence * const &cor_ , const size_t &idx_ , const pair<const Node * , size_t> &loc_) : cor(cor_) , idx(idx_) , epoch(cor_ -> epoch) , loc(loc_) {}
+
+		const pair<const Node * , size_t> &where() const
+		{
+			if (epoch != cor -> epoch)
+			{
+				pair<Node * , size_t> loc_ = cor -> locate(idx);
+				loc.first = loc_.first , loc.second = loc_.second , epoch = cor -> epoch;
+			}
+			return loc;
+		}
+	public:
+		const_iterator() : cor(nullptr) , idx(0) , epoch(0) {}
+		const_iterator(const const_iterator &other) : cor(other.cor) , idx(other.idx) , epoch(other.epoch) , loc(other.loc) {}
+		const_iterator(const iterator &other) : cor(other.cor) , idx(other.idx) , epoch(other.epoch) , loc(other.loc.first , other.loc.second) {}
+		const_iterator &operator=(const const_iterator &rhs) {cor = rhs.cor , idx = rhs.idx , epoch = rhs.epoch , loc.first = rhs.loc.first , loc.second = rhs.loc.second;return *this;}
+		const_iterator operator+(const int &n) const
+		{
+			if (n < 0) return operator-(-n);
+			if (idx + n > cor -> size()) throw(invalid_iterator());
+			const pair<const Node * , size_t> &cur = where();
+			if (cur.first && cur.second + n < cur.first -> tot) return const_iterator(cor , idx + n , pair<const Node * , size_t>(cur.first , cur.second + n));
+			return const_iterator(cor , idx + n);
+		}
+		const_iterator operator-(const int &n) const
+		{
+			if (n < 0) return operator+(-n);
+			if (idx < (size_t)n) throw(invalid_iterator());
+			const pair<const Node * , size_t> &cur = where();
+			if (cur.first && (size_t)n <= cur.second) return const_iterator(cor , idx - n , pair<const Node * , size_t>(cur.first , cur.second - n));
+			return const_iterator(cor , idx - n);
+		}
+		int operator-(const const_iterator &rhs) const
+		{
+			if (cor != rhs.cor) throw(invalid_iterator());
+			return (int)idx - (int)rhs.idx;
+		}
+		const_iterator& operator+=(const int &n) {return (*this) = (*this) + n;}
+		const_iterator& operator-=(const int &n) {return (*this) = (*this) - n;}
+		const_iterator operator++(int)
+		{
+			const_iterator ret = *this;
+			(*this) = (*this) + 1;
+			return ret;
+		}
+		const_iterator& operator++() {return (*this) = (*this) + 1;}
+		const_iterator operator--(int)
+		{
+			const_iterator ret = *this;
+			(*this) = (*this) - 1;
+			return ret;
+		}
+		const_iterator& operator--() {return (*this) = (*this) - 1;}
+		const T& operator*() const
+		{
+			if (idx >= cor -> size()) throw(invalid_iterator());
+			const pair<const Node * , size_t> &cur = where();
+			return cur.first -> data()[cur.second];
+		}
+		const T* operator->() const noexcept
+		{
+			const pair<const Node * , size_t> &cur = where();
+			return cur.first -> data() + cur.second;
+		}
+		bool operator==(const const_iterator &rhs) const {return cor == rhs.cor && idx == rhs.idx;}
+		bool operator==(const iterator &rhs) const {return cor == rhs.cor && idx == rhs.idx;}
+		bool operator!=(const const_iterator &rhs) const {return !(*this == rhs);}
+		bool operator!=(const iterator &rhs) const {return !(*this == rhs);}
+	};
+
+	sequence() : root(nullptr) , epoch(0) , seed(2463534242u) {}
+	sequence(const sequence &other) : root(copy(other.root)) , epoch(0) , seed(other.seed) {}
+	~sequence() {clear(root);}
+	sequence &operator=(const sequence &other)
+	{
+		if (&other == this) return *this;
+		clear(root) , root = copy(other.root) , ++ epoch;
+		return *this;
+	}
+	/**
+	 * access specified element with bounds checking
+	 * throw index_out_of_bound if out of bound.
+	 */
+	const T & at(const size_t &pos) const
+	{
+		if (pos >= size()) throw(index_out_of_bound());
+		pair<Node * , size_t> loc = locate(pos);
+		return loc.first -> data()[loc.second];
+	}
+	T & at(const size_t &pos) {return const_cast<T &>(static_cast<const sequence &>(*this).at(pos));}
+	T & operator[](const size_t &pos) {return at(pos);}
+	const T & operator[](const size_t &pos) const {return at(pos);}
+	/**
+	 * access the first or the last element
+	 * throw container_is_empty when the container is empty.
+	 */
+	const T & front() const
+	{
+		if (!root) throw(container_is_empty());
+		return at(0);
+	}
+	T & front() {return const_cast<T &>(static_cast<const sequence &>(*this).front());}
+	const T & back() const
+	{
+		if (!root) throw(container_is_empty());
+		return at(size() - 1);
+	}
+	T & back() {return const_cast<T &>(static_cast<const sequence &>(*this).back());}
+	iterator begin() {return iterator(this , 0);}
+	const_iterator cbegin() const {return const_iterator(this , 0);}
+	iterator end() {return iterator(this , size());}
+	const_iterator cend() const {return const_iterator(this , size());}
+	bool empty() const {return !root;}
+	size_t size() const {return sum(root);}
+	void clear() {clear(root) , root = nullptr , ++ epoch;}
+	/**
+	 * inserts value before pos and returns an iterator pointing to it.
+	 *     throw if the iterator is invalid or it point to a wrong place.
+	 */
+	iterator insert(iterator pos, const T &value)
+	{
+		if (pos.cor != this || pos.idx > size()) throw(runtime_error());
+		insert(pos.idx , value);
+		return iterator(this , pos.idx);
+	}
+	/**
+	 * removes the element at pos and returns an iterator pointing to the following element.
+	 * throw if the container is empty, the iterator is invalid or it points to a wrong place.
+	 */
+	iterator erase(iterator pos)
+	{
+		if (pos.cor != this || pos.idx >= size()) throw(runtime_error());
+		root = erase(root , pos.idx) , ++ epoch;
+		return iterator(this , pos.idx);
+	}
+	void push_back(const T &value) {insert(size() , value);}
+	void push_front(const T &value) {insert(0 , value);}
+	/**
+	 * removes the last or the first element.
+	 *     throw when the container is empty.
+	 */
+	void pop_back()
+	{
+		if (!root) throw(container_is_empty());
+		root = erase(root , size() - 1) , ++ epoch;
+	}
+	void pop_front()
+	{
+		if (!root) throw(container_is_empty());
+		root = erase(root , 0) , ++ epoch;
+	}
+	/**
+	 * moves the elements from index on into a new sequence, which is returned, in O(log n + chunk).
+	 * the two pieces of a cut chunk are merged into their neighbours when they fit.
+	 * throw index_out_of_bound if index > size().
+	 */
+	sequence split_at(const size_t &index)
+	{
+		if (index > size()) throw(index_out_of_bound());
+		sequence ret;
+		Node *n;
+		split(root , index , root , ret.root) , ++ epoch;
+		if (root && root -> sum != root -> tot) root = pop_back(root , n) , root = join(root , n);
+		if (ret.root && ret.root -> sum != ret.root -> tot) ret.root = pop_front(ret.root , n) , ret.root = join(n , ret.root);
+		return ret;
+	}
+	/**
+	 * moves all elements of other to the end of this sequence in O(log n + chunk), leaving other empty.
+	 * the chunks at the seam are merged when they fit, so repeated splits and appends keep chunks full.
+	 * throw runtime_error if other is this sequence.
+	 */
+	void append(sequence &&other)
+	{
+		if (&other == this) throw(runtime_error());
+		root = join(root , other.root) , other.root = nullptr , ++ epoch , ++ other.epoch;
+	}
+};
+
+}
+
+#endif
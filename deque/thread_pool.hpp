@@ -0,0 +1,196 @@
+#ifndef SJTU_THREAD_POOL_HPP
+#define SJTU_THREAD_POOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "deque.hpp"
+#include "work_stealing_deque.hpp"
+
+namespace sjtu
+{
+/**
+ * a fork-join thread pool. every worker owns a work_stealing_deque: tasks spawned by a worker go
+ * to the bottom of its own deque and are popped from there, idle workers steal from the top of
+ * the others'. tasks spawned from outside the pool go through a locked injection queue.
+ * a task belongs to a counter, which spawn raises and the end of the task lowers; wait(counter)
+ * keeps running tasks until the counter drops to zero, so a task may spawn children and wait
+ * for them without blocking its worker.
+ */
+class thread_pool
+{
+public:
+	typedef std::atomic<size_t> counter;
+	static const size_t max_depth = 64;
+private:
+	struct Task
+	{
+		std::function<void()> fn;
+		counter *join;
+	};
+
+	struct Worker
+	{
+		thread_pool *pool;
+		work_stealing_deque<Task *> tasks;
+		std::thread thread;
+	};
+
+	Worker *workers;
+	size_t worker_cnt;
+	std::mutex lock;//guards inject and the sleeping workers
+	std::condition_variable wake;
+	deque<Task *> inject;
+	std::atomic<size_t> queued , sleeping;
+	std::atomic<bool> stop;
+
+	//the worker the calling thread runs, if it is a worker of any pool
+	static Worker *&self()
+	{
+		static thread_local Worker *worker = nullptr;
+		return worker;
+	}
+
+	Worker *mine() const
+	{
+		Worker *w = self();
+		return w && w -> pool == this ? w : nullptr;
+	}
+
+	//nested waits on one thread; a waiting task only steals while this is below max_depth
+	static size_t &depth()
+	{
+		static thread_local size_t d = 0;
+		return d;
+	}
+
+	bool take(Worker *w , Task *&task , bool steal = true)
+	{
+		if (w && w -> tasks.pop(task)) return true;
+		if (!steal) return false;
+		size_t start = w ? w - workers + 1 : 0;
+		for (size_t i = 0;i < worker_cnt;++ i)
+			if (workers[(start + i) % worker_cnt].tasks.steal(task)) return true;
+		std::lock_guard<std::mutex> guard(lock);
+		if (inject.empty()) return false;
+		task = inject.front() , inject.pop_front();
+		return true;
+	}
+
+	void run(Task *task)
+	{
+		-- queued , task -> fn();
+		task -> join -> fetch_sub(1 , std::memory_order_release);
+		delete task;
+	}
+
+	//hands each segment of a container to the pool as a task of join
+	template <class Function>
+	struct Segments
+	{
+		thread_pool *pool;
+		counter *join;
+		const Function *f;
+
+		template <class Pointer>
+		void operator()(Pointer first , Pointer last) const
+		{
+			const Function *fn = f;
+			pool -> spawn(*join , [fn , first , last] {(*fn)(first , last);});
+		}
+	};
+
+	void work(Worker *w)
+	{
+		self() = w;
+		for (Task *task;!stop.load(std::memory_order_acquire);)
+		{
+			if (take(w , task)) {run(task);continue;}
+			std::unique_lock<std::mutex> guard(lock);
+			++ sleeping;
+			wake.wait_for(guard , std::chrono::milliseconds(1) , [this] {return queued.load() || stop.load();});
+			-- sleeping;
+		}
+	}
+public:
+	explicit thread_pool(size_t threads = std::thread::hardware_concurrency()) : worker_cnt(threads ? threads : 1) , queued(0) , sleeping(0) , stop(false)
+	{
+		workers = new Worker [worker_cnt];
+		for (size_t i = 0;i < worker_cnt;++ i) workers[i].pool = this;
+		for (size_t i = 0;i < worker_cnt;++ i) workers[i].thread = std::thread(&thread_pool::work , this , workers + i);
+	}
+	thread_pool(const thread_pool &) = delete;
+	thread_pool &operator=(const thread_pool &) = delete;
+	/**
+	 * stops the workers; tasks that never ran are dropped.
+	 */
+	~thread_pool()
+	{
+		stop.store(true , std::memory_order_release);
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			wake.notify_all();
+		}
+		for (size_t i = 0;i < worker_cnt;++ i) workers[i].thread.join();
+		Task *task;
+		for (size_t i = 0;i < worker_cnt;++ i)
+			for (;workers[i].tasks.pop(task);) delete task;
+		for (;!inject.empty();inject.pop_front()) delete inject.front();
+		delete [] workers;
+	}
+	/**
+	 * run fn on the pool as part of join.
+	 */
+	template <class Function>
+	void spawn(counter &join, Function &&fn) {
+		join.fetch_add(1 , std::memory_order_relaxed) , ++ queued;
+		Task *task = new Task {std::function<void()>(std::forward<Function>(fn)) , &join};
+		Worker *w = mine();
+		if (w) w -> tasks.push(task);
+		else
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			inject.push_back(task);
+		}
+		if (sleeping.load(std::memory_order_relaxed))
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			wake.notify_one();
+		}
+	}
+	/**
+	 * run tasks of the pool until join drops to zero.
+	 * a thread outside the pool only yields. a worker first runs its own tasks, which are
+	 * children of the waiting one; it steals others' only while its waits are nested less than
+	 * max_depth deep, since every stolen task may wait again on top of the same stack.
+	 */
+	void wait(counter &join) {
+		Worker *w = mine();
+		size_t &d = depth();
+		++ d;
+		for (Task *task;join.load(std::memory_order_acquire);)
+			if (w && take(w , task , d < max_depth)) run(task);
+			else std::this_thread::yield();
+		-- d;
+	}
+	/**
+	 * call f(first, last) on every contiguous segment of c (see deque::for_each_segment) as a task of
+	 * the pool, and return once all of them are done. f runs on several segments at once.
+	 */
+	template <class Container , class Function>
+	void for_each_segment(Container &c , const Function &f) {
+		counter join(0);
+		c.for_each_segment(Segments<Function> {this , &join , &f});
+		wait(join);
+	}
+	size_t size() const {return worker_cnt;}
+};
+
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef SJTU_WORK_STEALING_DEQUE_HPP
+#define SJTU_WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace sjtu
+{
+/**
+ * a lock-free work-stealing deque (Chase and Lev, with the C11 orderings of Le et al.).
+ * one owner thread pushes and pops at the bottom; any number of thieves steal from the top.
+ * the circular array doubles when full; old arrays may still be read by a slow thief, so they
+ * are kept until the deque is destroyed.
+ * elements are copied in and out with plain atomic loads and stores, so T must be trivially
+ * copyable; tasks are passed as pointers.
+ */
+template <class T>
+class work_stealing_deque
+{
+	static_assert(std::is_trivially_copyable<T>::value, "work_stealing_deque moves T through atomics");
+private:
+	struct Array
+	{
+		long long cap;
+		std::atomic<T> *buf;
+		Array *prev;//the array this one replaced
+
+		Array(const long long &cap_ , Array *prev_) : cap(cap_) , buf(new std::atomic<T> [cap_]) , prev(prev_) {}
+		~Array() {delete [] buf;}
+
+		T get(const long long &i) const {return buf[i & cap - 1].load(std::memory_order_relaxed);}
+		void put(const long long &i , const T &value) {buf[i & cap - 1].store(value , std::memory_order_relaxed);}
+	};
+
+	alignas(64) std::atomic<long long> top;
+	alignas(64) std::atomic<long long> bottom;
+	std::atomic<Array *> array;
+
+	Array *grow(Array *a , const long long &b , const long long &t)
+	{
+		Array *na = new Array (a -> cap << 1 , a);
+		for (long long i = t;i < b;++ i) na -> put(i , a -> get(i));
+		array.store(na , std::memory_order_release);
+		return na;
+	}
+public:
+	/**
+	 * capacity is rounded up to a power of two.
+	 */
+	explicit work_stealing_deque(long long capacity = 64) : top(0) , bottom(0)
+	{
+		long long cap = 1;
+		for (;cap < capacity;cap <<= 1);
+		array.store(new Array (cap , nullptr) , std::memory_order_relaxed);
+	}
+	work_stealing_deque(const work_stealing_deque &) = delete;
+	work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+	~work_stealing_deque()
+	{
+		for (Array *a = array.load(std::memory_order_relaxed) , *prev;a;a = prev) prev = a -> prev , delete a;
+	}
+	/**
+	 * owner only: push value at the bottom.
+	 */
+	void push(const T &value) {
+		long long b = bottom.load(std::memory_order_relaxed) , t = top.load(std::memory_order_acquire);
+		Array *a = array.load(std::memory_order_relaxed);
+		if (b - t > a -> cap - 1) a = grow(a , b , t);
+		a -> put(b , value);
+		bottom.store(b + 1 , std::memory_order_release);//a release store rather than a fence, the same on x86
+	}
+	/**
+	 * owner only: take the most recently pushed element into out.
+	 * @return false if the deque was empty or a thief took the last element first.
+	 */
+	bool pop(T &out) {
+		long long b = bottom.load(std::memory_order_relaxed) - 1;
+		Array *a = array.load(std::memory_order_relaxed);
+		bottom.store(b , std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		long long t = top.load(std::memory_order_relaxed);
+		if (t > b) {bottom.store(b + 1 , std::memory_order_relaxed);return false;}
+		out = a -> get(b);
+		if (t < b) return true;
+		bool won = top.compare_exchange_strong(t , t + 1 , std::memory_order_seq_cst , std::memory_order_relaxed);
+		bottom.store(b + 1 , std::memory_order_relaxed);
+		return won;
+	}
+	/**
+	 * any thread: take the oldest element into out.
+	 * @return false if the deque was empty or another thread got the element first.
+	 */
+	bool steal(T &out) {
+		long long t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		long long b = bottom.load(std::memory_order_acquire);
+		if (t >= b) return false;
+		out = array.load(std::memory_order_acquire) -> get(t);
+		return top.compare_exchange_strong(t , t + 1 , std::memory_order_seq_cst , std::memory_order_relaxed);
+	}
+	/**
+	 * a snapshot of the number of elements; exact only when no other thread is working on the deque.
+	 */
+	size_t size() const {
+		long long b = bottom.load(std::memory_order_relaxed) , t = top.load(std::memory_order_relaxed);
+		return b > t ? b - t : 0;
+	}
+	bool empty() const {return !size();}
+};
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+#include "map.hpp"
+#include <iostream>
+#include <cstdio>
+#include <map>
+#include <string>
+
+//copies, assignments and clears against std::map; nodes are recycled through slabs, so the live
+//object count must still match the elements held
+class Counted {
+public:
+	static int counter;
+	std::string s;
+
+	Counted(const std::string &s = "") : s(s) {counter++;}
+	Counted(const Counted &rhs) : s(rhs.s) {counter++;}
+	Counted &operator=(const Counted &rhs) {s = rhs.s; return *this;}
+	~Counted() {counter--;}
+};
+
+int Counted::counter = 0;
+
+unsigned seed = 1000000007;
+unsigned rnd(){
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+bool same(sjtu::map<int, Counted> &m, const std::map<int, std::string> &stl){
+	if(m.size() != stl.size()) return 0;
+	std::map<int, std::string>::const_iterator it = stl.begin();
+	for(sjtu::map<int, Counted>::const_iterator jt = m.cbegin(); jt != m.cend(); ++jt, ++it)
+		if(jt->first != it->first || jt->second.s != it->second) return 0;
+	return 1;
+}
+
+int main(){
+	bool ok = 1;
+	{
+		sjtu::map<int, Counted> m, copy;
+		std::map<int, std::string> stl, saved;
+		for(int i = 0; i < 300000; i++){
+			int op = rnd() % 100, k = rnd() % 5000;
+			if(op < 60){
+				std::string v = std::to_string(rnd());
+				m[k] = Counted(v), stl[k] = v;
+			}
+			else if(op < 97){
+				sjtu::map<int, Counted>::iterator it = m.find(k);
+				if((it == m.end()) != !stl.count(k)) ok = 0;
+				if(it != m.end()) m.erase(it), stl.erase(k);
+			}
+			else if(op < 98){
+				sjtu::map<int, Counted> fresh(m);
+				if(!same(fresh, stl)) ok = 0;
+				copy = fresh, saved = stl;
+			}
+			else if(op < 99){
+				m = copy, stl = saved;
+			}
+			else m.clear(), stl.clear();
+			if(Counted::counter != (int)(m.size() + copy.size())) ok = 0;
+		}
+		if(!same(m, stl) || !same(copy, saved)) ok = 0;
+		sjtu::map<int, Counted> deep;
+		for(int i = 0; i < 1000000; i++) deep[i] = Counted();
+		sjtu::map<int, Counted> deep2(deep);
+		deep = m;
+		if(deep2.size() != 1000000 || !same(deep, stl)) ok = 0;
+	}
+	if(Counted::counter) ok = 0;
+	puts(ok ? "ok" : "wrong");
+	return 0;
+}
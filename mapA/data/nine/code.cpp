@@ -0,0 +1,61 @@
+#include "map.hpp"
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+//erased nodes go back to their slab, and a slab whose nodes are all erased has to be given back:
+//the bytes held from operator new are tracked while a map grows and is erased from one end, and
+//while it churns at a steady size
+size_t held = 0;
+
+void *operator new(size_t n){
+	size_t *p = (size_t *)malloc(n + sizeof(max_align_t));
+	if(!p) throw std::bad_alloc();
+	*p = n, held += n;
+	return (char *)p + sizeof(max_align_t);
+}
+void operator delete(void *p) noexcept{
+	if(!p) return;
+	size_t *q = (size_t *)((char *)p - sizeof(max_align_t));
+	held -= *q, free(q);
+}
+void *operator new[](size_t n){return operator new(n);}
+void operator delete[](void *p) noexcept{operator delete(p);}
+void operator delete(void *p, size_t) noexcept{operator delete(p);}
+void operator delete[](void *p, size_t) noexcept{operator delete(p);}
+void *operator new(size_t n, const std::nothrow_t &) noexcept{
+	try { return operator new(n); } catch(...) { return 0; }
+}
+void *operator new[](size_t n, const std::nothrow_t &) noexcept{return operator new(n, std::nothrow);}
+
+int main(){
+	bool ok = 1;
+	size_t empty = held;
+	{
+		sjtu::map<int, long long> m;
+		for(int i = 0; i < 100000; i++) m[i] = i;
+		size_t full = held - empty;
+		for(int i = 0; i < 90000; i++) m.erase(m.begin());
+		if(held - empty > full / 2) ok = 0, puts("erasing 90% kept most slabs");
+		for(int i = 0; i < 200000; i++){
+			int k = 100000 + i;
+			m[k] = k;
+			m.erase(m.begin());
+		}
+		if(held - empty > full) ok = 0, puts("churn grew the slabs");
+		int k = 290000;
+		for(sjtu::map<int, long long>::iterator jt = m.begin(); jt != m.end(); ++jt, ++k) if(jt->first != k || jt->second != k) { ok = 0; break; }
+		if(k != 300000) ok = 0;
+		while(m.size()) m.erase(m.begin());
+		if(held - empty > 4096) ok = 0, puts("erasing everything kept slabs");
+		for(int i = 0; i < 1000; i++) m[i] = i;
+		for(int i = 0; i < 1000; i += 2) m.erase(m.find(i));
+		k = 1;
+		for(sjtu::map<int, long long>::iterator jt = m.begin(); jt != m.end(); ++jt, k += 2) if(jt->first != k || jt->second != k) { ok = 0; break; }
+		if(k != 1001 || m.size() != 500) ok = 0;
+	}
+	if(held != empty) ok = 0, puts("leaked");
+	puts(ok ? "ok" : "wrong");
+	return 0;
+}
@@ -7,6 +7,7 @@
 // only for std::less<T>
 #include <functional>
 #include <cstddef>
+#include <new>
 #include "utility.hpp"
 #include "exceptions.hpp"
 
@@ -35,19 +36,96 @@ private:
 
 	struct Node
 	{
-		value_type *value;
+		value_type *value;//points into storage, nullptr for nil
 		color_type color;
 		Node *left , *right , *parent;
+		alignas(value_type) unsigned char storage[sizeof(value_type)];
 
-		Node (value_type * const &value_ = nullptr , const color_type &color_ = BLACK) : value(value_) , color(color_) , left(nullptr) , right(nullptr) , parent(nullptr) {}
-		Node (const Node &other) : value(new value_type (*other.value)) , color(other.color) , left(nullptr) , right(nullptr) , parent(nullptr) {}
+		Node () : value(nullptr) , color(BLACK) , left(nullptr) , right(nullptr) , parent(nullptr) {}
+		Node (const value_type &value_ , const color_type &color_) : value(new (storage) value_type (value_)) , color(color_) , left(nullptr) , right(nullptr) , parent(nullptr) {}
+		Node (const Node &other) = delete;
 		Node &operator=(const Node &other) = delete;
-		~Node () {delete value;}
+		~Node () {if (value) value -> ~value_type();}
 	}*nil , *nodebegin;
 
+	//nodes are carved out of slabs and recycled through spare, a list linked through their first word.
+	//the slabs are kept sorted by address; once the live count has halved since its peak, erase() gives
+	//back the slabs whose nodes are all spare, and clear() and the destructor give back the rest
+	struct alignas(Node) Slab
+	{
+		Slab *next;
+		size_t cnt , idle;//nodes carved out of the slab, and how many of them trim() found spare
+	}*slabs;
+	Node *spare;
+	size_t spares , peak;
+
 	Compare compare;
 	size_t tot;
 
+	static Node *&link(Node *x) {return *reinterpret_cast<Node **>(x);}
+
+	void grow(const size_t &cnt)
+	{
+		Slab *slab = new (::operator new(sizeof(Slab) + cnt * sizeof(Node))) Slab {nullptr , cnt , 0} , **pos = &slabs;
+		while (*pos && std::less<Slab *>()(*pos , slab)) pos = &(*pos) -> next;
+		slab -> next = *pos , *pos = slab;
+		Node *raw = reinterpret_cast<Node *>(slab + 1);
+		for (size_t i = cnt;i --;) link(raw + i) = spare , spare = raw + i;
+		spares += cnt;
+	}
+
+	void reserve(const size_t &cnt) {if (spares < cnt) grow(cnt - spares);}
+
+	Node *make(const value_type &value , const color_type &color)
+	{
+		if (!spare) grow(tot > 16 ? tot : 16);
+		Node *x = spare , *nxt = link(x);
+		new (x) Node (value , color) , spare = nxt , -- spares;
+		if (tot >= peak) peak = tot + 1;
+		return x;
+	}
+
+	void release(Node *x) {x -> ~Node() , link(x) = spare , spare = x , ++ spares;}
+
+	//the slab holding node x among the cnt slabs of sorted, in address order
+	static Slab *owner(Slab ** const &sorted , const size_t &cnt , Node * const &x)
+	{
+		size_t l = 0 , r = cnt;//sorted[l] <= x < sorted[r]
+		for (size_t mid;r - l > 1;)
+			mid = (l + r) >> 1 , (std::less<Slab *>()(reinterpret_cast<Slab *>(x) , sorted[mid]) ? r : l) = mid;
+		return sorted[l];
+	}
+
+	//gives back the slabs whose nodes are all spare, in O(spares log slabs): each spare node is counted
+	//against its slab, and the spare list is rebuilt without the nodes of the slabs that go
+	void trim()
+	{
+		size_t cnt = 0;
+		for (Slab *slab = slabs;slab;slab = slab -> next) slab -> idle = 0 , ++ cnt;
+		Slab **sorted = new (std::nothrow) Slab *[cnt];
+		if (!sorted) return;
+		cnt = 0;
+		for (Slab *slab = slabs;slab;slab = slab -> next) sorted[cnt ++] = slab;
+		for (Node *x = spare;x;x = link(x)) ++ owner(sorted , cnt , x) -> idle;
+		Node *x = spare , *nxt;
+		for (spare = nullptr , spares = 0;x;x = nxt)
+		{
+			Slab *slab = owner(sorted , cnt , x);
+			nxt = link(x);
+			if (slab -> idle != slab -> cnt) link(x) = spare , spare = x , ++ spares;
+		}
+		for (Slab **pos = &slabs , *slab;*pos;)
+			if ((slab = *pos) -> idle == slab -> cnt) *pos = slab -> next , ::operator delete(slab);
+			else pos = &slab -> next;
+		delete [] sorted , peak = tot;
+	}
+
+	void free_slabs()
+	{
+		for (Slab *nxt;slabs;slabs = nxt) nxt = slabs -> next , ::operator delete(slabs);
+		spare = nullptr , spares = peak = 0;
+	}
+
 	void left_rotate(Node *x)
 	{
 		Node *y = x -> parent;
@@ -221,26 +299,47 @@ private:
 			transplant(x , z);
 			z -> color = x -> color , z -> left = x -> left , z -> left -> parent = z;
 		}
-		delete x , -- tot;
+		release(x) , -- tot;
 		if (col == BLACK) erase_fixup(y) , nil -> parent = nil;
 		nodebegin = findmin(nil);
+		if (tot <= peak >> 1 && spares > tot + 16) trim();
 	}
 
-	Node *copy(Node *x , Node * const &nilx , Node * const &nily)
+	Node *clone(Node * const &x , Node * const &parent)
 	{
-		if (x == nilx) return nily;
-		Node *y = new Node (*x);++ tot;
-		y -> left = copy(x -> left , nilx , nily) , y -> right = copy(x -> right , nilx , nily) , y -> parent = nil;
-		if (y -> left != nily) y -> left -> parent = y;
-		if (y -> right != nily) y -> right -> parent = y;
+		Node *y = make(*x -> value , x -> color);
+		y -> left = y -> right = nil , y -> parent = parent , ++ tot;
 		return y;
 	}
 
+	//copies the subtree at x of a map whose sentinel is nilx without recursion: both trees are walked
+	//in step along the parent links, and from tells which side of x the walk came from
+	Node *copy(Node *x , Node * const &nilx)
+	{
+		if (x == nilx) return nil;
+		Node *root = x , *y = clone(x , nil);
+		for (Node *from = nilx;;)
+			if (from == x -> parent && x -> left != nilx) y -> left = clone(x -> left , y) , y = y -> left , from = x , x = x -> left;
+			else if (from != x -> right && x -> right != nilx) y -> right = clone(x -> right , y) , y = y -> right , from = x , x = x -> right;
+			else if (x == root) return y;
+			else from = x , x = x -> parent , y = y -> parent;
+	}
+
+	//destroys the subtree at x without recursion, cutting off leaves from the bottom up
 	void clear(Node *&x)
 	{
 		if (x == nil) return;
 		if (x -> parent == nil) nodebegin = nil;
-		clear(x -> left) , clear(x -> right) , delete x , x = nil , -- tot;
+		for (Node *y = x , *top = x -> parent , *up;y != top;)
+			if (y -> left != nil) y = y -> left;
+			else if (y -> right != nil) y = y -> right;
+			else
+			{
+				up = y -> parent;
+				if (up != top) (up -> left == y ? up -> left : up -> right) = nil;
+				release(y) , -- tot , y = up;
+			}
+		x = nil;
 	}
 public:
 	/**
@@ -377,12 +476,12 @@ public:
 	/**
 	 * TODO two constructors
 	 */
-	map() {nodebegin = nil = new Node , nil -> parent = nil -> left = nil -> right = nil , tot = 0;}
+	map() : slabs(nullptr) , spare(nullptr) , spares(0) , peak(0) {nodebegin = nil = new Node , nil -> parent = nil -> left = nil -> right = nil , tot = 0;}
 
-	map(const map &other)
+	map(const map &other) : slabs(nullptr) , spare(nullptr) , spares(0) , peak(0)
 	{
 		nil = new Node , nil -> parent = nil -> right = nil , tot = 0;
-		nil -> left = copy(other.nil -> left , other.nil , nil);
+		reserve(other.tot) , nil -> left = copy(other.nil -> left , other.nil);
 		nodebegin = findmin(nil);
 	}
 	/**
@@ -391,14 +490,14 @@ public:
 	map & operator=(const map &other)
 	{
 		if (&other == this) return *this;
-		clear(nil -> left) , nil -> left = copy(other.nil -> left , other.nil , nil);
+		clear(nil -> left) , reserve(other.tot) , nil -> left = copy(other.nil -> left , other.nil);
 		nodebegin = findmin(nil);
 		return *this;
 	}
 	/**
 	 * TODO Destructors
 	 */
-	~map() {clear(nil -> left) , delete nil;}
+	~map() {clear(nil -> left) , free_slabs() , delete nil;}
 	/**
 	 * TODO
 	 * access specified element with bounds checking
@@ -422,7 +521,7 @@ public:
 	T & operator[](const Key &key)
 	{
 		Node *node = search(key);
-		if (node == nil) node = new Node (new value_type (key , T()) , RED) , insert(node);
+		if (node == nil) node = make(value_type (key , T()) , RED) , insert(node);
 		return node -> value -> second;
 	}
 	/**
@@ -452,7 +551,7 @@ public:
 	/**
 	 * clears the contents
 	 */
-	void clear() {clear(nil -> left);}
+	void clear() {clear(nil -> left) , free_slabs();}
 	/**
 	 * insert an element.
 	 * return a pair, the first of the pair is
@@ -464,7 +563,7 @@ public:
 		Node *node = search(value.first);
 		if (node == nil)
 		{
-			node = new Node (new value_type (value) , RED) , insert(node);
+			node = make(value , RED) , insert(node);
 			return pair<iterator , bool>(iterator(this , node) , true);
 		}
 		else return pair<iterator , bool>(iterator(this , node) , false);
@@ -0,0 +1,109 @@
+// Dijkstra on a random sparse graph: radix_heap against the LeftistTree-backed sjtu::priority_queue.
+// build: g++ -O2 -I.. dijkstra.cpp -o dijkstra
+#include <iostream>
+#include <ctime>
+#include <vector>
+
+#include "priority_queue.hpp"
+#include "radix_heap.hpp"
+
+static const int N = 1000000, M = 5000000, MAXW = 100000;
+
+unsigned long long now = 1;
+unsigned rnd()
+{
+	now = now * 6364136223846793005ull + 1442695040888963407ull;
+	return now >> 33;
+}
+
+struct Edge
+{
+	int to;
+	unsigned w;
+};
+
+std::vector<int> head;
+std::vector<Edge> edge;
+
+void build()
+{
+	std::vector<int> deg(N + 1, 0);
+	std::vector<int> from(M);
+	std::vector<Edge> e(M);
+	for (int i = 0; i < M; ++i) {
+		from[i] = i < N - 1 ? i : rnd() % N;
+		e[i].to = i < N - 1 ? i + 1 : rnd() % N;
+		e[i].w = rnd() % MAXW + 1;
+		++deg[from[i] + 1];
+	}
+	for (int i = 1; i <= N; ++i) deg[i] += deg[i - 1];
+	head = deg, edge.resize(M);
+	for (int i = 0; i < M; ++i) edge[deg[from[i]]++] = e[i];
+}
+
+struct Item
+{
+	unsigned long long dist;
+	int u;
+};
+
+struct ItemGreater
+{
+	bool operator()(const Item &a, const Item &b) const { return a.dist > b.dist; }
+};
+
+unsigned long long checksum(const std::vector<unsigned long long> &dist)
+{
+	unsigned long long ret = 0;
+	for (int i = 0; i < N; ++i) ret = ret * 1000003 + dist[i];
+	return ret;
+}
+
+unsigned long long RunLeftist()
+{
+	std::vector<unsigned long long> dist(N, ~0ull);
+	sjtu::priority_queue<Item, ItemGreater> pq;
+	dist[0] = 0, pq.push(Item{0, 0});
+	while (!pq.empty()) {
+		Item cur = pq.top();
+		pq.pop();
+		if (cur.dist != dist[cur.u]) continue;
+		for (int i = head[cur.u]; i < head[cur.u + 1]; ++i)
+			if (cur.dist + edge[i].w < dist[edge[i].to])
+				dist[edge[i].to] = cur.dist + edge[i].w, pq.push(Item{dist[edge[i].to], edge[i].to});
+	}
+	return checksum(dist);
+}
+
+unsigned long long RunRadix()
+{
+	std::vector<unsigned long long> dist(N, ~0ull);
+	sjtu::radix_heap<unsigned long long, int> rh;
+	dist[0] = 0, rh.push(0, 0);
+	while (!rh.empty()) {
+		unsigned long long d = rh.top().first;
+		int u = rh.top().second;
+		rh.pop();
+		if (d != dist[u]) continue;
+		for (int i = head[u]; i < head[u + 1]; ++i)
+			if (d + edge[i].w < dist[edge[i].to])
+				dist[edge[i].to] = d + edge[i].w, rh.push(dist[edge[i].to], edge[i].to);
+	}
+	return checksum(dist);
+}
+
+int main()
+{
+	build();
+	std::cout << "graph: " << N << " vertices, " << M << " edges" << std::endl;
+	clock_t start = clock();
+	unsigned long long a = RunLeftist();
+	double ta = 1.0 * (clock() - start) / CLOCKS_PER_SEC;
+	start = clock();
+	unsigned long long b = RunRadix();
+	double tb = 1.0 * (clock() - start) / CLOCKS_PER_SEC;
+	std::cout << "leftist tree: " << ta << "s" << std::endl;
+	std::cout << "radix heap:   " << tb << "s" << std::endl;
+	std::cout << (a == b ? "distances agree" : "DISTANCES DIFFER") << std::endl;
+	return a != b;
+}
@@ -0,0 +1,70 @@
+// comparator invocations and time for Util::Bint elements, plain priority_queue against keyed_priority_queue.
+// build: g++ -O2 -I.. -I../../vector/data keyed.cpp -o keyed
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <ctime>
+
+#include "class-bint.hpp"
+#include "priority_queue.hpp"
+
+static const int N = 20000, DIGITS = 40;
+
+unsigned long long now = 1;
+unsigned rnd()
+{
+	now = now * 6364136223846793005ull + 1442695040888963407ull;
+	return now >> 33;
+}
+
+// order-preserving 64-bit key: sign, decimal length and the first 15 digits
+struct BintKey
+{
+	unsigned long long operator()(const Util::Bint &x) const
+	{
+		std::ostringstream os;
+		os << x;
+		std::string s = os.str();
+		bool minus = s[0] == '-';
+		if (minus) s = s.substr(1);
+		unsigned long long prefix = 0;
+		for (size_t i = 0; i < 15; ++i) prefix = prefix * 10 + (i < s.size() ? s[i] - '0' : 0);
+		unsigned long long mag = (unsigned long long)s.size() << 50 | prefix;
+		return minus ? (1ull << 63) - 1 - mag : (1ull << 63) + mag;
+	}
+};
+
+typedef dslib::CountingCompare<Util::Bint> Counted;
+
+template <class Queue>
+void run(const char *name, const Util::Bint *values, unsigned long long &checksum)
+{
+	Counted::calls = 0, checksum = 0;
+	clock_t start = clock(), spent;
+	Queue q;
+	for (int i = 0; i < N; ++i) q.push(values[i]);
+	spent = clock() - start;
+	BintKey key;
+	while (!q.empty()) {
+		checksum = checksum * 1000003 + key(q.top());
+		start = clock(), q.pop(), spent += clock() - start;
+	}
+	std::cout << name << ": " << 1.0 * spent / CLOCKS_PER_SEC << "s, " << Counted::calls << " Bint comparisons" << std::endl;
+}
+
+int main()
+{
+	Util::Bint *values = new Util::Bint[N];
+	for (int i = 0; i < N; ++i) {
+		std::string s(1, '1' + rnd() % 9);
+		// a fifth of the values share their leading digits, so key ties do happen
+		for (int j = 1; j < DIGITS; ++j) s += char('0' + (i % 5 == 0 && j < 20 ? 7 : rnd() % 10));
+		values[i] = Util::Bint(s);
+	}
+	unsigned long long a, b;
+	run<sjtu::priority_queue<Util::Bint, Counted> >("plain", values, a);
+	run<sjtu::keyed_priority_queue<Util::Bint, BintKey, Counted> >("keyed", values, b);
+	std::cout << (a == b ? "orders agree" : "ORDERS DIFFER") << std::endl;
+	delete [] values;
+	return a != b;
+}
@@ -0,0 +1,45 @@
+// meld-heavy workload: every tick, many small queues are built and merged into one large queue,
+// then a few elements are popped from it.
+// build: g++ -O2 -I.. meld.cpp -o meld
+#include <iostream>
+#include <ctime>
+
+#include "priority_queue.hpp"
+
+static const int TICKS = 200, QUEUES = 20000, QUEUE_SIZE = 4, POPS = 1000;
+
+unsigned long long now = 1;
+unsigned rnd()
+{
+	now = now * 6364136223846793005ull + 1442695040888963407ull;
+	return now >> 33;
+}
+
+template <class Queue>
+double run(const char *name, unsigned long long &checksum)
+{
+	now = 1, checksum = 0;
+	clock_t start = clock();
+	Queue big;
+	Queue *small = new Queue[QUEUES];
+	for (int t = 0; t < TICKS; ++t) {
+		for (int i = 0; i < QUEUES; ++i)
+			for (int j = 0; j < QUEUE_SIZE; ++j) small[i].push(rnd());
+		for (int i = 0; i < QUEUES; ++i) big.merge(small[i]);
+		for (int i = 0; i < POPS; ++i) checksum = checksum * 31 + big.top(), big.pop();
+	}
+	delete [] small;
+	double ret = 1.0 * (clock() - start) / CLOCKS_PER_SEC;
+	std::cout << name << ": " << ret << "s, final size " << big.size() << std::endl;
+	return ret;
+}
+
+int main()
+{
+	unsigned long long a, b, c;
+	run<sjtu::priority_queue<unsigned> >("leftist tree", a);
+	run<sjtu::priority_queue<unsigned, std::less<unsigned>, dslib::LeftistTree<unsigned, std::less<unsigned>, true> > >("skew heap   ", b);
+	run<sjtu::priority_queue<unsigned, std::less<unsigned>, dslib::PairingHeap<unsigned> > >("pairing heap", c);
+	std::cout << (a == b && b == c ? "results agree" : "RESULTS DIFFER") << std::endl;
+	return !(a == b && b == c);
+}
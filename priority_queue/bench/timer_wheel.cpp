@@ -0,0 +1,101 @@
+// timer workload: 10M timers scheduled up to horizon ticks ahead of now, a tenth of them cancelled,
+// time advanced one tick at a time while due events are drained.
+// build: g++ -O2 -I.. timer_wheel.cpp -o timer_wheel
+#include <iostream>
+#include <ctime>
+#include <vector>
+
+#include "priority_queue.hpp"
+#include "timer_wheel.hpp"
+
+static const int TIMERS = 10000000, PER_TICK = 1000;
+
+unsigned long long now = 1;
+unsigned rnd()
+{
+	now = now * 6364136223846793005ull + 1442695040888963407ull;
+	return now >> 33;
+}
+
+struct Sink
+{
+	unsigned long long *sum;
+	Sink &operator*() { return *this; }
+	Sink &operator++() { return *this; }
+	Sink &operator=(const int &x) { *sum += x; return *this; }
+};
+
+unsigned long long RunWheel(int horizon, double &seconds)
+{
+	now = 1;
+	unsigned long long sum = 0;
+	Sink sink = {&sum};
+	std::vector<sjtu::timer_wheel<int>::timer> handle(TIMERS);
+	clock_t start = clock();
+	sjtu::timer_wheel<int> w;
+	for (int i = 0; i < TIMERS;) {
+		for (int j = 0; j < PER_TICK; ++j, ++i) {
+			handle[i] = w.schedule(w.now() + 1 + rnd() % horizon, i);
+			if (i % 10 == 9) w.cancel(handle[i - 5 - rnd() % 5]);
+		}
+		w.advance(w.now() + 1), w.pop_due(sink);
+	}
+	w.advance(w.now() + horizon), w.pop_due(sink);
+	seconds = 1.0 * (clock() - start) / CLOCKS_PER_SEC;
+	return sum;
+}
+
+struct Event
+{
+	unsigned long long when;
+	int id;
+};
+
+struct LaterFirst
+{
+	bool operator()(const Event &a, const Event &b) const { return b.when < a.when; }
+};
+
+unsigned long long RunLeftist(int horizon, double &seconds)
+{
+	now = 1;
+	unsigned long long sum = 0, cur = 0;
+	std::vector<bool> cancelled(TIMERS, false), fired(TIMERS, false);
+	clock_t start = clock();
+	sjtu::priority_queue<Event, LaterFirst> pq;
+	for (int i = 0; i < TIMERS;) {
+		for (int j = 0; j < PER_TICK; ++j, ++i) {
+			pq.push(Event{cur + 1 + rnd() % horizon, i});
+			if (i % 10 == 9) {
+				// cancellation is lazy: the event stays in the heap and is skipped when it surfaces
+				int victim = i - 5 - rnd() % 5;
+				cancelled[victim] = !fired[victim] && !cancelled[victim] ? true : cancelled[victim];
+			}
+		}
+		for (++cur; !pq.empty() && pq.top().when <= cur; pq.pop()) {
+			fired[pq.top().id] = true;
+			if (!cancelled[pq.top().id]) sum += pq.top().id;
+		}
+	}
+	for (cur += horizon; !pq.empty(); pq.pop())
+		if (!cancelled[pq.top().id]) sum += pq.top().id;
+	seconds = 1.0 * (clock() - start) / CLOCKS_PER_SEC;
+	return sum;
+}
+
+int main()
+{
+	const int horizons[2] = {200, 5000};
+	for (int h = 0; h < 2; ++h) {
+		double tw, tl;
+		unsigned long long a = RunWheel(horizons[h], tw), b = RunLeftist(horizons[h], tl);
+		std::cout << "horizon " << horizons[h] << " ticks" << std::endl;
+		std::cout << "  timer wheel:  " << tw << "s, " << TIMERS / tw / 1e6 << "M timers/s" << std::endl;
+		std::cout << "  leftist tree: " << tl << "s, " << TIMERS / tl / 1e6 << "M timers/s" << std::endl;
+		if (a != b) {
+			std::cout << "FIRED EVENTS DIFFER" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <iterator>
+
+#include "priority_queue.hpp"
+
+long long aa = 13131, bb = 5353, MOD = 1e9 + 7, now = 1;
+int rand()
+{
+	for (int i = 1; i < 3; i++)
+		now = (now * aa + bb) % MOD;
+	return now;
+}
+
+class T2//pointer + no_construct
+{
+public:
+	int *data;
+	T2(int key) : data(new int(key)) {}
+	T2(const T2 &other) : data(new int(*(other.data))) {}
+	T2 &operator=(const T2 &other)
+	{
+		if (this == &other) return *this;
+		delete data;
+		data = new int(*(other.data));
+		return *this;
+	}
+	~T2() {delete data;}
+};
+
+struct cmp
+{
+	bool operator()(const T2 &a, const T2 &b) const {return *(a.data) < *(b.data);}
+};
+
+template <class Queue>
+void test(const char *name)
+{
+	std::cout << "Testing " << name << "..." << std::endl;
+	Queue q[10];
+	std::priority_queue<int> ref;
+	bool ok = true;
+	for (int i = 0; i < 60000; ++i) {
+		int x = rand() % 100000;
+		q[i % 10].push(T2(x)), ref.push(x);
+		if (i % 1000 == 999)
+			for (int j = 1; j < 10; ++j) q[0].merge(q[j]);
+		if (i % 7 == 0) {
+			for (int j = 1; j < 10; ++j) q[0].merge(q[j]);
+			ok &= *(q[0].top().data) == ref.top();
+			q[0].pop(), ref.pop();
+		}
+	}
+	for (int j = 1; j < 10; ++j) q[0].merge(q[j]), ok &= q[j].empty();
+	q[0].merge(q[0]);
+	std::cout << q[0].size() << " " << ref.size() << std::endl;
+	Queue copy(q[0]), assign;
+	assign = copy;
+	std::vector<T2> batch;
+	for (int i = 0; i < 5000; ++i) batch.push_back(T2(rand() % 100000)), ref.push(*(batch.back().data));
+	assign.push_batch(batch.begin(), batch.end());
+	std::vector<T2> out;
+	while (assign.size() >= 64) {
+		assign.pop_k(64, std::back_inserter(out));
+		for (size_t i = out.size() - 64; i < out.size(); ++i) ok &= *(out[i].data) == ref.top(), ref.pop();
+	}
+	while (!assign.empty()) ok &= *(assign.top().data) == ref.top(), assign.pop(), ref.pop();
+	std::cout << (ok ? "Pop in order." : "Wrong order.") << std::endl;
+	std::cout << copy.size() << " " << q[0].size() << std::endl;
+	try {
+		assign.pop();
+	} catch (sjtu::container_is_empty) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	test<sjtu::priority_queue<T2, cmp> >("leftist tree");
+	test<sjtu::priority_queue<T2, cmp, dslib::LeftistTree<T2, cmp, true> > >("skew heap");
+	test<sjtu::priority_queue<T2, cmp, dslib::PairingHeap<T2, cmp> > >("pairing heap");
+	return 0;
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <queue>
+#include <csignal>
+#include <sys/resource.h>
+
+#include "external_priority_queue.hpp"
+
+long long aa = 13131, bb = 5353, MOD = 1e9 + 7, now = 1;
+int rand()
+{
+	for (int i = 1; i < 3; i++)
+		now = (now * aa + bb) % MOD;
+	return now;
+}
+
+struct Job
+{
+	int priority, id;
+};
+
+struct cmp
+{
+	bool operator()(const Job &a, const Job &b) const {return a.priority < b.priority || (a.priority == b.priority && a.id > b.id);}
+};
+
+void TestSpill()
+{
+	std::cout << "Testing spilled runs..." << std::endl;
+	// 4096 bytes of budget: 32 jobs of 32-byte heap nodes in memory, blocks of 16 jobs
+	sjtu::external_priority_queue<Job, cmp> q(4096, 16);
+	std::priority_queue<Job, std::vector<Job>, cmp> ref;
+	bool ok = true;
+	size_t most = 0;
+	for (int i = 0; i < 100000; ++i) {
+		Job job = {rand() % 10000, i};
+		q.push(job), ref.push(job);
+		if (q.runs_open() > most) most = q.runs_open();
+		if (i % 4 == 0) {
+			ok &= q.top().id == ref.top().id;
+			q.pop(), ref.pop();
+		}
+	}
+	std::cout << q.size() << " " << ref.size() << std::endl;
+	while (!ref.empty()) {
+		ok &= q.top().id == ref.top().id;
+		q.pop(), ref.pop();
+	}
+	std::cout << (ok ? "Pop in order." : "Wrong order.") << std::endl;
+	// 3072 bytes of buffers hold 24 blocks: 23 open runs and the one being merged into
+	std::cout << "open runs at most " << most << std::endl;
+	std::cout << q.runs_written() << " " << q.write_count() << " " << q.read_count() << std::endl;
+	std::cout << q.bytes_written() << " " << q.bytes_read() << std::endl;
+}
+
+void TestInMemory()
+{
+	std::cout << "Testing in-memory use..." << std::endl;
+	sjtu::external_priority_queue<int> q;
+	for (int i = 0; i < 1000; ++i) q.push(i * 7 % 1000);
+	long long sum = 0;
+	for (int i = 0; i < 5; ++i) sum = sum * 1000 + q.top(), q.pop();
+	std::cout << sum << " " << q.size() << " " << q.runs_written() << " " << q.bytes_written() << std::endl;
+	try {
+		sjtu::external_priority_queue<int> e;
+		e.pop();
+	} catch (sjtu::container_is_empty) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+}
+
+// a full disk: writes beyond a small file size limit fail, and every element must still come out
+void TestWriteFailure()
+{
+	std::cout << "Testing failed writes..." << std::endl;
+	sjtu::external_priority_queue<Job, cmp> q(4096, 16);
+	std::priority_queue<Job, std::vector<Job>, cmp> ref;
+	signal(SIGXFSZ, SIG_IGN);
+	rlimit old, small;
+	getrlimit(RLIMIT_FSIZE, &old);
+	small = old, small.rlim_cur = 4000;
+	setrlimit(RLIMIT_FSIZE, &small);
+	int failures = 0;
+	for (int i = 0; i < 8000; ++i) {
+		Job job = {rand() % 10000, i};
+		ref.push(job);
+		try {
+			q.push(job);
+		} catch (sjtu::runtime_error) {
+			++failures;
+		}
+	}
+	setrlimit(RLIMIT_FSIZE, &old);
+	bool ok = q.size() == ref.size();
+	for (; ok && !ref.empty(); q.pop(), ref.pop()) ok = q.top().id == ref.top().id;
+	std::cout << (failures ? "Write failed. " : "No failure. ") << (ok ? "Nothing lost." : "Elements lost.") << std::endl;
+}
+
+int main()
+{
+	TestSpill();
+	TestWriteFailure();
+	TestInMemory();
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <iterator>
+
+#include "priority_queue.hpp"
+
+long long aa = 13131, bb = 5353, MOD = 1e9 + 7, now = 1;
+int rand()
+{
+	for (int i = 1; i < 3; i++)
+		now = (now * aa + bb) % MOD;
+	return now;
+}
+
+// a coarse key, so that many elements tie and the full comparison still matters
+struct Bucket
+{
+	unsigned operator()(const int &x) const {return x >> 6;}
+};
+
+typedef dslib::CountingCompare<int> Counted;
+
+template <class Queue>
+void test(const char *name)
+{
+	std::cout << "Testing " << name << "..." << std::endl;
+	Queue q, other;
+	std::priority_queue<int> ref;
+	bool ok = true;
+	for (int i = 0; i < 30000; ++i) {
+		int x = rand() % 100000;
+		(i & 1 ? q : other).push(x), ref.push(x);
+		if (i % 5 == 0) {
+			q.merge(other);
+			ok &= q.top() == ref.top();
+			q.pop(), ref.pop();
+		}
+	}
+	std::vector<int> batch;
+	for (int i = 0; i < 3000; ++i) batch.push_back(rand() % 100000), ref.push(batch.back());
+	q.push_batch(batch.begin(), batch.end());
+	q.merge(other);
+	Queue copy(q);
+	std::vector<int> out;
+	copy.pop_k(copy.size(), std::back_inserter(out));
+	for (size_t i = 0; i < out.size(); ++i) ok &= out[i] == ref.top(), ref.pop();
+	std::cout << (ok ? "Pop in order." : "Wrong order.") << std::endl;
+	std::cout << q.size() << " " << copy.size() << " " << out.size() << std::endl;
+}
+
+int main()
+{
+	test<sjtu::priority_queue<int, Counted> >("plain");
+	size_t plain = Counted::calls;
+	Counted::calls = 0;
+	test<sjtu::keyed_priority_queue<int, Bucket, Counted> >("keyed leftist tree");
+	std::cout << (Counted::calls < plain / 2 ? "Fewer comparisons." : "Too many comparisons.") << std::endl;
+	test<sjtu::keyed_priority_queue<int, Bucket, Counted,
+		dslib::PairingHeap<dslib::KeyedValue<int, Bucket>, dslib::KeyedCompare<int, Bucket, Counted> > > >("keyed pairing heap");
+	return 0;
+}
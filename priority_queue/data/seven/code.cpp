@@ -0,0 +1,91 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+
+#include "radix_heap.hpp"
+
+long long aa = 13131, bb = 5353, MOD = 1e9 + 7, now = 1;
+int rand()
+{
+	for (int i = 1; i < 3; i++)
+		now = (now * aa + bb) % MOD;
+	return now;
+}
+
+class T1//no_construct
+{
+public:
+	int data;
+	T1(int key) : data(key) {}
+};
+
+void TestMonotone()
+{
+	std::cout << "Testing monotone push and pop..." << std::endl;
+	sjtu::radix_heap<unsigned, T1> rh;
+	std::priority_queue<unsigned, std::vector<unsigned>, std::greater<unsigned> > ref;
+	bool ok = true;
+	unsigned base = 0;
+	for (int i = 0; i < 100000; ++i) {
+		if (rand() % 3) {
+			unsigned key = base + rand() % 1000;
+			rh.push(key, T1(key)), ref.push(key);
+		} else if (!ref.empty()) {
+			ok &= rh.top().first == ref.top() && rh.top().second.data == (int)ref.top();
+			base = ref.top();
+			rh.pop(), ref.pop();
+		}
+		ok &= rh.size() == ref.size();
+	}
+	sjtu::radix_heap<unsigned, T1> copy(rh);
+	while (!ref.empty()) {
+		ok &= copy.top().first == ref.top();
+		copy.pop(), ref.pop();
+	}
+	std::cout << (ok ? "Pop in order." : "Wrong order.") << std::endl;
+	std::cout << rh.size() << " " << copy.size() << std::endl;
+	copy = rh;
+	std::cout << copy.size() << std::endl;
+}
+
+void TestWideKeys()
+{
+	std::cout << "Testing 64-bit keys..." << std::endl;
+	sjtu::radix_heap<unsigned long long, int> rh;
+	rh.push(1ull << 63, 3), rh.push(0, 1), rh.push(1ull << 40, 2), rh.push(~0ull, 4);
+	while (!rh.empty()) std::cout << rh.top().second << " ", rh.pop();
+	std::cout << std::endl;
+	rh = sjtu::radix_heap<unsigned long long, int>();
+	rh.push(7, 1), rh.push(9, 5), rh.push(7, 2);
+	int first = rh.top().second;
+	rh.pop(), rh.push(7, 3);
+	int second = rh.top().second;
+	rh.pop();
+	int third = rh.top().second;
+	rh.pop();
+	std::cout << first + second + third << " " << (first != second && second != third && first != third) << " " << rh.top().second << std::endl;
+}
+
+void TestException()
+{
+	sjtu::radix_heap<unsigned, int> rh;
+	try {
+		rh.pop();
+	} catch (...) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+	rh.push(10, 0), rh.pop();
+	try {
+		rh.push(9, 0);
+	} catch (...) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	TestMonotone();
+	TestWideKeys();
+	TestException();
+	return 0;
+}
@@ -0,0 +1,76 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+long long aa = 13131, bb = 5353, MOD = 1e9 + 7, now = 1;
+int rand()
+{
+	for (int i = 1; i < 3; i++)
+		now = (now * aa + bb) % MOD;
+	return now;
+}
+
+void TestPushBatch()
+{
+	std::cout << "Testing push_batch..." << std::endl;
+	sjtu::priority_queue<int> pq;
+	std::priority_queue<int> ref;
+	for (int round = 0; round < 20; ++round) {
+		std::vector<int> batch;
+		for (int i = 0; i < 1000 + round * 37; ++i) batch.push_back(rand() % 100000);
+		pq.push_batch(batch.begin(), batch.end());
+		for (size_t i = 0; i < batch.size(); ++i) ref.push(batch[i]);
+		for (int i = 0; i < 500; ++i) {
+			if (pq.top() != ref.top()) {
+				std::cout << "Wrong top." << std::endl;
+				return;
+			}
+			pq.pop(), ref.pop();
+		}
+	}
+	std::cout << pq.size() << " " << ref.size() << std::endl;
+	int empty[1];
+	pq.push_batch(empty, empty);
+	std::cout << pq.size() << std::endl;
+	long long sum = 0;
+	while (!pq.empty()) sum += pq.top(), pq.pop();
+	std::cout << sum << std::endl;
+}
+
+void TestPopK()
+{
+	std::cout << "Testing pop_k..." << std::endl;
+	sjtu::priority_queue<int> pq;
+	std::priority_queue<int> ref;
+	for (int i = 0; i < 50000; ++i) {
+		int x = rand() % 1000;
+		pq.push(x), ref.push(x);
+	}
+	int out[64];
+	bool ok = true;
+	while (!ref.empty()) {
+		size_t k = ref.size() < 64 ? ref.size() : 64;
+		int *end = pq.pop_k(k, out);
+		if (end != out + k) ok = false;
+		for (size_t i = 0; i < k; ++i) ok &= out[i] == ref.top(), ref.pop();
+		if (pq.size() != ref.size()) ok = false;
+	}
+	std::cout << (ok ? "Pop in order." : "Wrong order.") << std::endl;
+	std::cout << pq.pop_k(0, out) - out << std::endl;
+	pq.push(1);
+	try {
+		pq.pop_k(2, out);
+	} catch (...) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+	std::cout << pq.size() << std::endl;
+}
+
+int main()
+{
+	TestPushBatch();
+	TestPopK();
+	return 0;
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <set>
+
+#include "minmax_priority_queue.hpp"
+
+long long aa = 13131, bb = 5353, MOD = 1e9 + 7, now = 1;
+int rand()
+{
+	for (int i = 1; i < 3; i++)
+		now = (now * aa + bb) % MOD;
+	return now;
+}
+
+class T2//pointer + no_construct
+{
+public:
+	int *data;
+	T2(int key) : data(new int(key)) {}
+	T2(const T2 &other) : data(new int(*(other.data))) {}
+	T2 &operator=(const T2 &other) = delete;
+	~T2() {delete data;}
+};
+
+struct cmp
+{
+	bool operator()(const T2 &a, const T2 &b) const {return *(a.data) < *(b.data);}
+};
+
+void TestRandom()
+{
+	std::cout << "Testing push, pop_min and pop_max..." << std::endl;
+	sjtu::minmax_priority_queue<T2, cmp> q;
+	std::multiset<int> ref;
+	bool ok = true;
+	for (int i = 0; i < 200000; ++i) {
+		int op = rand() % 5;
+		if (op < 3 || ref.empty()) {
+			int x = rand() % 1000;
+			q.push(T2(x)), ref.insert(x);
+		} else if (op == 3) {
+			ok &= *(q.min().data) == *ref.begin();
+			q.pop_min(), ref.erase(ref.begin());
+		} else {
+			ok &= *(q.max().data) == *ref.rbegin();
+			q.pop_max(), ref.erase(--ref.end());
+		}
+		ok &= q.size() == ref.size();
+		if (!ref.empty()) ok &= *(q.min().data) == *ref.begin() && *(q.max().data) == *ref.rbegin();
+	}
+	std::cout << (ok ? "Correct." : "Wrong answer.") << std::endl;
+	sjtu::minmax_priority_queue<T2, cmp> copy(q), assign;
+	assign = copy, assign = assign;
+	std::cout << q.size() << " " << copy.size() << " " << assign.size() << std::endl;
+	while (!copy.empty()) copy.pop_max();
+	while (assign.size() > 1) assign.pop_min();
+	std::cout << *(assign.min().data) << " " << *(assign.max().data) << " " << *ref.rbegin() << std::endl;
+}
+
+void TestSmall()
+{
+	std::cout << "Testing small sizes..." << std::endl;
+	sjtu::minmax_priority_queue<int> q;
+	for (int i = 1; i <= 7; ++i) {
+		q.push(i * 3 % 7);
+		std::cout << q.min() << " " << q.max() << " ";
+	}
+	std::cout << std::endl;
+	while (!q.empty()) {
+		std::cout << q.max() << " ";
+		q.pop_max();
+		if (!q.empty()) std::cout << q.min() << " ", q.pop_min();
+	}
+	std::cout << std::endl;
+}
+
+void TestException()
+{
+	sjtu::minmax_priority_queue<int> q;
+	try {
+		q.min();
+	} catch (sjtu::container_is_empty) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+	try {
+		q.pop_max();
+	} catch (sjtu::container_is_empty) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	TestRandom();
+	TestSmall();
+	TestException();
+	return 0;
+}
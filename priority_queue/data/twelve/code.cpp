@@ -0,0 +1,83 @@
+#include <iostream>
+#include <map>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#include "timer_wheel.hpp"
+
+long long aa = 13131, bb = 5353, MOD = 1e9 + 7, now = 1;
+int rand()
+{
+	for (int i = 1; i < 3; i++)
+		now = (now * aa + bb) % MOD;
+	return now;
+}
+
+typedef sjtu::timer_wheel<int> wheel;
+
+void TestAgainstMap(const char *name, unsigned long long start, unsigned long long spread, unsigned long long step)
+{
+	std::cout << "Testing " << name << "..." << std::endl;
+	wheel w(start);
+	std::multimap<unsigned long long, int> ref;
+	std::vector<wheel::timer> handle;
+	std::vector<bool> alive;
+	bool ok = true;
+	size_t fired = 0;
+	for (int round = 0; round < 2000; ++round) {
+		for (int i = 0; i < 20; ++i) {
+			unsigned long long when = w.now() + (rand() % 8 == 0 ? 0 : (unsigned long long)rand() * rand() % spread);
+			int id = handle.size();
+			handle.push_back(w.schedule(when, id)), alive.push_back(true), ref.insert(std::make_pair(when, id));
+		}
+		for (int i = 0; i < 5; ++i) {
+			int id = rand() % handle.size();
+			if (!alive[id]) continue;
+			unsigned long long when = handle[id].when();
+			for (std::multimap<unsigned long long, int>::iterator it = ref.lower_bound(when); ; ++it)
+				if (it->second == id) {
+					ref.erase(it);
+					break;
+				}
+			w.cancel(handle[id]), alive[id] = false;
+		}
+		w.advance(w.now() + (unsigned long long)rand() * rand() % step);
+		std::vector<int> got, expect;
+		w.pop_due(std::back_inserter(got));
+		while (!ref.empty() && ref.begin()->first <= w.now())
+			expect.push_back(ref.begin()->second), ref.erase(ref.begin());
+		for (size_t i = 0; i < got.size(); ++i) alive[got[i]] = false;
+		std::sort(got.begin(), got.end()), std::sort(expect.begin(), expect.end());
+		ok &= got == expect && w.size() == ref.size();
+		fired += got.size();
+	}
+	std::cout << (ok ? "Fired correctly." : "Wrong events.") << " " << fired << " " << w.size() << std::endl;
+}
+
+void TestException()
+{
+	wheel w;
+	wheel::timer t;
+	try {
+		w.cancel(t);
+	} catch (sjtu::invalid_iterator) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+	t = w.schedule(5, 1);
+	w.cancel(t);
+	try {
+		w.cancel(t);
+	} catch (sjtu::invalid_iterator) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	TestAgainstMap("near events", 0, 3000, 300);
+	TestAgainstMap("far events", 123456789, 1ull << 40, 1ull << 36);
+	TestAgainstMap("wrap around level blocks", (1ull << 32) - 1000, 1ull << 20, 1ull << 16);
+	TestException();
+	return 0;
+}
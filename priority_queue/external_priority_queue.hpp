@@ -0,0 +1,243 @@
+#ifndef SJTU_EXTERNAL_PRIORITY_QUEUE_HPP
+#define SJTU_EXTERNAL_PRIORITY_QUEUE_HPP
+#include <cstddef>
+#include <cstdio>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include "exceptions.hpp"
+#include "utility.hpp"
+#include "priority_queue.hpp"
+
+namespace sjtu {
+
+/**
+ * a priority queue that can outgrow memory.
+ * new elements go to an in-memory heap of bounded size; when it fills up, it is drained
+ * in order into a sorted run in a temporary file. top() and pop() look at the in-memory
+ * heap and at the heads of all runs, which are merged through a small heap of run heads
+ * and refilled by buffered sequential reads. every open run holds one read buffer, so
+ * when another run would not fit in the budget, the half of the runs with the fewest
+ * elements left are first merged into one, level by level as in an external merge sort.
+ * T is written to disk byte for byte, so it must be trivially copyable.
+ */
+template<typename T, class Compare = std::less<T>, class Heap = dslib::LeftistTree<T, Compare>>
+class external_priority_queue {
+	static_assert(std::is_trivially_copyable<T>::value, "external_priority_queue stores T as raw bytes");
+private:
+	struct Run
+	{
+		FILE *file;
+		T *buffer;
+		size_t pos , len , remaining;//remaining counts the elements still on disk
+	};
+
+	struct Head
+	{
+		T val;
+		size_t run;
+
+		Head(const T &val_ , const size_t &run_) : val(val_) , run(run_) {}
+	};
+
+	struct HeadCompare
+	{
+		bool operator()(const Head &lhs , const Head &rhs) const {return Compare()(lhs.val , rhs.val);}
+	};
+
+	Heap heap;
+	dslib::LeftistTree<Head , HeadCompare> heads;
+	Run *runs;
+	size_t run_cnt , run_space , live , max_runs , fan;//live runs still hold a file and a buffer
+	size_t heap_limit , block , tot;
+	size_t written , read_calls , write_calls , read_bytes , write_bytes;
+
+	bool read_block(Run &run)
+	{
+		if (!run.remaining) return false;
+		size_t want = run.remaining < block ? run.remaining : block;
+		if (fread(run.buffer , sizeof(T) , want , run.file) != want) throw(runtime_error());
+		run.pos = 0 , run.len = want , run.remaining -= want;
+		++ read_calls , read_bytes += want * sizeof(T);
+		return true;
+	}
+
+	//pushes the next element of run i into heads, releasing the run once it is exhausted
+	void advance(const size_t &i)
+	{
+		Run &run = runs[i];
+		if (run.pos == run.len && !read_block(run))
+		{
+			fclose(run.file) , delete [] reinterpret_cast<char *>(run.buffer);
+			run.file = nullptr , run.buffer = nullptr , -- live;
+			return;
+		}
+		heads.push(Head(run.buffer[run.pos ++] , i));
+	}
+
+	//elements of run i not yet handed out, its head in heads included
+	size_t left(const size_t &i) const {return runs[i].remaining + runs[i].len - runs[i].pos + 1;}
+
+	//opens an empty run with its buffer in the first exhausted slot and returns its index;
+	//nothing is taken from anywhere before it exists
+	size_t open_run()
+	{
+		size_t i = 0;
+		while (i < run_cnt && runs[i].file != nullptr) ++ i;
+		if (i == run_space)
+		{
+			Run *runs_ = new Run [run_space <<= 1];
+			for (size_t j = 0;j < run_cnt;++ j) runs_[j] = runs[j];
+			delete [] runs , runs = runs_;
+		}
+		Run &run = runs[i];
+		if ((run.file = tmpfile()) == nullptr) throw(runtime_error());
+		run.buffer = reinterpret_cast<T *>(new char [block * sizeof(T)]);
+		run.remaining = run.pos = run.len = 0 , ++ live , ++ written;
+		if (i == run_cnt) ++ run_cnt;
+		return i;
+	}
+
+	//starts reading run i from the beginning
+	void close_run(const size_t &i) {rewind(runs[i].file) , advance(i);}
+
+	//appends n elements of buf to run i. if the write fails they go back into the in-memory heap and
+	//the run is closed with what reached the file, so no element is lost, then runtime_error is thrown
+	void write_block(const size_t &i , const T *buf , const size_t &n)
+	{
+		Run &run = runs[i];
+		if (fwrite(buf , sizeof(T) , n , run.file) == n && !fflush(run.file))
+		{
+			run.remaining += n , ++ write_calls , write_bytes += n * sizeof(T);
+			return;
+		}
+		for (size_t j = 0;j < n;++ j) heap.push(buf[j]);
+		close_run(i);
+		throw(runtime_error());
+	}
+
+	//merges the fan runs with the fewest elements left into a new one, holding one buffer more than the runs
+	//do. the larger runs are left alone, so an element is rewritten once per level, about log_fan(n / heap_limit)
+	//times, instead of once per merge. heads holds one head per live run; the ones of the other runs wait in rest
+	void merge_runs()
+	{
+		size_t *sizes = new size_t [live] , n = 0;
+		for (size_t i = 0;i < run_cnt;++ i) if (runs[i].file != nullptr) sizes[n ++] = left(i);
+		std::nth_element(sizes , sizes + fan - 1 , sizes + n);
+		size_t cut = sizes[fan - 1] , ties = fan;
+		for (size_t i = 0;i < fan;++ i) if (sizes[i] < cut) -- ties;
+		delete [] sizes;
+		dslib::LeftistTree<Head , HeadCompare> pick , rest;
+		for (;!heads.empty();heads.pop())
+		{
+			size_t s = left(heads.top().run);
+			(s < cut || (s == cut && ties && ties --) ? pick : rest).push(heads.top());
+		}
+		heads.join(pick);
+		try
+		{
+			size_t out = open_run() , cnt = 0;
+			for (T *buf = runs[out].buffer;!heads.empty();)
+			{
+				size_t i = heads.top().run;
+				buf[cnt ++] = heads.top().val , heads.pop() , advance(i);
+				if (cnt == block || heads.empty()) write_block(out , buf , cnt) , cnt = 0;
+			}
+			close_run(out);//the picked runs are exhausted and their slots free
+		}
+		catch (...) {heads.join(rest) , throw;}
+		heads.join(rest);
+	}
+
+	void spill()
+	{
+		if (live >= max_runs) merge_runs();
+		size_t i = open_run();
+		for (size_t cnt;!heap.empty();)
+		{
+			cnt = heap.size() < block ? heap.size() : block;
+			heap.pop_k(cnt , runs[i].buffer) , write_block(i , runs[i].buffer , cnt);
+		}
+		close_run(i);
+	}
+
+	//whether the largest element is the head of a run rather than the top of the in-memory heap
+	bool top_on_disk() const {return !heads.empty() && (heap.empty() || Compare()(heap.top() , heads.top().val));}
+public:
+	/**
+	 * memory_budget is the number of bytes kept in memory: a quarter goes to the in-memory heap,
+	 * counted per node as the element, two links and one more word for the rank and the allocator,
+	 * the rest to buffers of block_size elements, one per open run and one for the run being written.
+	 * a budget too small for a heap of one block and three buffers is rounded up to that.
+	 */
+	explicit external_priority_queue(size_t memory_budget = 64 << 20, size_t block_size = 1 << 12)
+		: runs(new Run [4]) , run_cnt(0) , run_space(4) , live(0) , block(block_size) , tot(0) ,
+		  written(0) , read_calls(0) , write_calls(0) , read_bytes(0) , write_bytes(0)
+	{
+		heap_limit = memory_budget / 4 / (sizeof(T) + 3 * sizeof(void *));
+		if (heap_limit < block) heap_limit = block;
+		max_runs = (memory_budget - memory_budget / 4) / (block * sizeof(T));
+		max_runs = max_runs > 3 ? max_runs - 1 : 2;
+		fan = max_runs >> 1 > 2 ? max_runs >> 1 : 2;
+	}
+	external_priority_queue(const external_priority_queue &) = delete;
+	external_priority_queue &operator=(const external_priority_queue &) = delete;
+	~external_priority_queue()
+	{
+		for (size_t i = 0;i < run_cnt;++ i)
+			if (runs[i].file != nullptr) fclose(runs[i].file) , delete [] reinterpret_cast<char *>(runs[i].buffer);
+		delete [] runs;
+	}
+	/**
+	 * get the top of the queue.
+	 * throw container_is_empty if empty() returns true;
+	 */
+	const T & top() const {
+		if (!tot) throw(container_is_empty());
+		return top_on_disk() ? heads.top().val : heap.top();
+	}
+	/**
+	 * push new element, spilling the in-memory heap to a new run when it is full.
+	 */
+	void push(const T &e) {
+		heap.push(e) , ++ tot;
+		if (heap.size() >= heap_limit) spill();
+	}
+	/**
+	 * delete the top element.
+	 * throw container_is_empty if empty() returns true;
+	 */
+	void pop() {
+		if (!tot) throw(container_is_empty());
+		if (top_on_disk())
+		{
+			size_t run = heads.top().run;
+			heads.pop() , advance(run);
+		}
+		else heap.pop();
+		-- tot;
+	}
+	size_t size() const {
+		return tot;
+	}
+	bool empty() const {
+		return !tot;
+	}
+	/**
+	 * I/O counters: number of runs written (merged runs included), block reads and writes, and bytes moved.
+	 */
+	size_t runs_written() const {return written;}
+	/**
+	 * the number of runs on disk, each holding a file and a read buffer; never more than the budget allows.
+	 */
+	size_t runs_open() const {return live;}
+	size_t read_count() const {return read_calls;}
+	size_t write_count() const {return write_calls;}
+	size_t bytes_read() const {return read_bytes;}
+	size_t bytes_written() const {return write_bytes;}
+};
+
+}
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef SJTU_MINMAX_PRIORITY_QUEUE_HPP
+#define SJTU_MINMAX_PRIORITY_QUEUE_HPP
+#include <cstddef>
+#include <functional>
+#include "exceptions.hpp"
+#include "utility.hpp"
+
+namespace sjtu {
+
+/**
+ * a double-ended priority queue, stored as an array min-max heap.
+ * nodes on even levels are no larger than their descendants, nodes on odd levels no smaller,
+ * so the minimum is the root and the maximum is one of its children.
+ * elements are held through pointers, so sifting only moves pointers.
+ */
+template<typename T, class Compare = std::less<T>>
+class minmax_priority_queue {
+private:
+	T **heap;
+	size_t tot , capacity;
+
+	bool less(const size_t &lhs , const size_t &rhs) const {return Compare()(*heap[lhs] , *heap[rhs]);}
+
+	static bool on_min_level(size_t pos)
+	{
+		bool ret = 1;
+		for (++ pos;pos > 1;pos >>= 1) ret = !ret;
+		return ret;
+	}
+
+	void swap(const size_t &lhs , const size_t &rhs)
+	{
+		T *tmp = heap[lhs];
+		heap[lhs] = heap[rhs] , heap[rhs] = tmp;
+	}
+
+	//moves pos up through its grandparents, towards the root if is_min, else towards the largest level
+	void bubble_up(size_t pos , bool is_min)
+	{
+		for (size_t gp;pos > 2;pos = gp)
+		{
+			gp = (pos - 1 >> 1) - 1 >> 1;
+			if (is_min ? !less(pos , gp) : !less(gp , pos)) break;
+			swap(pos , gp);
+		}
+	}
+
+	void push_up(size_t pos)
+	{
+		if (!pos) return;
+		size_t parent = pos - 1 >> 1;
+		bool is_min = on_min_level(pos);
+		if (is_min ? less(parent , pos) : less(pos , parent)) swap(pos , parent) , bubble_up(parent , !is_min);
+		else bubble_up(pos , is_min);
+	}
+
+	//the smallest (is_min) or largest child or grandchild of pos, pos itself if it has none
+	size_t extreme_descendant(const size_t &pos , bool is_min) const
+	{
+		size_t ret = pos , child = (pos << 1) + 1;
+		for (size_t i = child;i < child + 2 && i < tot;++ i)
+		{
+			if (ret == pos || (is_min ? less(i , ret) : less(ret , i))) ret = i;
+			for (size_t j = (i << 1) + 1;j < (i << 1) + 3 && j < tot;++ j)
+				if (is_min ? less(j , ret) : less(ret , j)) ret = j;
+		}
+		return ret;
+	}
+
+	void push_down(size_t pos)
+	{
+		bool is_min = on_min_level(pos);
+		for (size_t m;(m = extreme_descendant(pos , is_min)) != pos;pos = m)
+		{
+			if (!(is_min ? less(m , pos) : less(pos , m))) break;
+			swap(m , pos);
+			if (m <= (pos << 1) + 2) break;
+			size_t parent = m - 1 >> 1;
+			if (is_min ? less(parent , m) : less(m , parent)) swap(m , parent);
+		}
+	}
+
+	size_t max_pos() const {return tot == 1 ? 0 : tot == 2 || less(2 , 1) ? 1 : 2;}
+
+	void remove(const size_t &pos)
+	{
+		delete heap[pos] , heap[pos] = heap[-- tot];
+		if (pos < tot) push_down(pos);
+	}
+
+	void copy(const minmax_priority_queue &other)
+	{
+		tot = other.tot , capacity = other.capacity , heap = new T *[capacity];
+		for (size_t i = 0;i < tot;++ i) heap[i] = new T (*other.heap[i]);
+	}
+
+	void clear()
+	{
+		for (size_t i = 0;i < tot;++ i) delete heap[i];
+		delete [] heap;
+	}
+public:
+	minmax_priority_queue() : heap(new T *[4]) , tot(0) , capacity(4) {}
+	minmax_priority_queue(const minmax_priority_queue &other) {copy(other);}
+	~minmax_priority_queue() {clear();}
+	minmax_priority_queue &operator=(const minmax_priority_queue &other)
+	{
+		if (this == &other) return *this;
+		clear() , copy(other);
+		return *this;
+	}
+	/**
+	 * get the smallest element.
+	 * throw container_is_empty if empty() returns true;
+	 */
+	const T & min() const {
+		if (!tot) throw(container_is_empty());
+		return *heap[0];
+	}
+	/**
+	 * get the largest element, the one priority_queue::top() would return.
+	 * throw container_is_empty if empty() returns true;
+	 */
+	const T & max() const {
+		if (!tot) throw(container_is_empty());
+		return *heap[max_pos()];
+	}
+	/**
+	 * push new element in O(log n).
+	 */
+	void push(const T &e) {
+		if (tot == capacity)
+		{
+			T **heap_ = new T *[capacity <<= 1];
+			for (size_t i = 0;i < tot;++ i) heap_[i] = heap[i];
+			delete [] heap , heap = heap_;
+		}
+		heap[tot] = new T (e) , push_up(tot ++);
+	}
+	/**
+	 * delete the smallest element in O(log n).
+	 * throw container_is_empty if empty() returns true;
+	 */
+	void pop_min() {
+		if (!tot) throw(container_is_empty());
+		remove(0);
+	}
+	/**
+	 * delete the largest element in O(log n).
+	 * throw container_is_empty if empty() returns true;
+	 */
+	void pop_max() {
+		if (!tot) throw(container_is_empty());
+		remove(max_pos());
+	}
+	size_t size() const {
+		return tot;
+	}
+	bool empty() const {
+		return !tot;
+	}
+};
+
+}
+
+#endif
@@ -25,26 +25,43 @@ namespace dslib
 	};
 
 	//LeftistTree.hpp
-	template <class valueType , class compare = std::less<valueType> >
+	//the rank of a leftist tree is at most log2(n + 1), so one byte is enough; skew mode keeps no rank at all
+	template <bool skew>
+	struct LeftistRank
+	{
+		unsigned char d;
+
+		LeftistRank() : d(0) {}
+	};
+
+	template <>
+	struct LeftistRank<true> {};
+
+	template <class valueType , class compare = std::less<valueType> , bool skew = false>
 	class LeftistTree : public PriorityQueue<valueType , compare>
 	{
 	private:
-		struct Node
+		struct Node : LeftistRank<skew>
 		{
-			size_t tot , d;
 			valueType val;
 			Node *left , *right;
 
-			Node(const valueType &val_) : val(val_) {}
+			Node(const valueType &val_) : val(val_) , left(nullptr) , right(nullptr) {}
 		}*root;
+		size_t tot;
+
+		static int rank(const Node * const &node) {return node == nullptr ? -1 : node -> d;}
 
 		Node *merge(Node * const & , Node * const &);
+		Node *merge(Node * const & , Node * const & , LeftistRank<false>);
+		Node *merge(Node * , Node * , LeftistRank<true>);
+		Node *meld_all(Node ** , size_t);
 		Node *copy(const Node * const &);
 		void clear(Node *&);
 	public:
-		LeftistTree(Node *root_ = nullptr) : root(root_) {};
-		LeftistTree(const LeftistTree<valueType , compare> &);
-		LeftistTree<valueType , compare> &operator=(const LeftistTree<valueType , compare> &);
+		LeftistTree() : root(nullptr) , tot(0) {};
+		LeftistTree(const LeftistTree<valueType , compare , skew> &);
+		LeftistTree<valueType , compare , skew> &operator=(const LeftistTree<valueType , compare , skew> &);
 
 		virtual bool empty() const override;
 		virtual size_t size() const override;
@@ -53,98 +70,389 @@ namespace dslib
 		virtual void push(const valueType &) override;
 		virtual void pop() override;
 
-		void join(LeftistTree<valueType , compare> &);
+		void join(LeftistTree<valueType , compare , skew> &);
+
+		template <class ForwardIterator> void push_batch(ForwardIterator , ForwardIterator);
+		template <class OutputIterator> OutputIterator pop_k(size_t , OutputIterator);
 
 		virtual ~LeftistTree();
 	};
 
+	template <class valueType , class compare , bool skew>
+	LeftistTree<valueType , compare , skew>::LeftistTree(const LeftistTree<valueType , compare , skew> &rhs){root = copy(rhs.root) , tot = rhs.tot;}
+
+	template <class valueType , class compare , bool skew>
+	LeftistTree<valueType , compare , skew> &LeftistTree<valueType , compare , skew>::operator=(const LeftistTree<valueType , compare , skew> &rhs)
+	{
+		if (this == &rhs) return *this;
+		clear(root) , root = copy(rhs.root) , tot = rhs.tot;
+		return *this;
+	}
+
+	template <class valueType , class compare , bool skew>
+	bool LeftistTree<valueType , compare , skew>::empty() const {return root == nullptr;}
+
+	template <class valueType , class compare , bool skew>
+	size_t LeftistTree<valueType , compare , skew>::size() const {return tot;}
+
+	template <class valueType , class compare , bool skew>
+	const valueType &LeftistTree<valueType , compare , skew>::top() const
+	{
+		if (empty()) throw(sjtu::container_is_empty());
+		return root -> val;
+	}
+
+	template <class valueType , class compare , bool skew>
+	void LeftistTree<valueType , compare , skew>::push(const valueType &val)
+	{
+		root = merge(root , new Node (val)) , ++ tot;
+	}
+
+	template <class valueType , class compare , bool skew>
+	void LeftistTree<valueType , compare , skew>::pop()
+	{
+		if (empty()) throw(sjtu::container_is_empty());
+		Node *rt = root;
+		root = merge(rt -> left , rt -> right) , delete rt , -- tot;
+	}
+
+	template <class valueType , class compare , bool skew>
+	void LeftistTree<valueType , compare , skew>::join(LeftistTree<valueType , compare , skew> &rhs)
+	{
+		if (this == &rhs) return;
+		root = merge(root , rhs.root) , tot += rhs.tot , rhs.root = nullptr , rhs.tot = 0;
+	}
+
+	template <class valueType , class compare , bool skew>
+	template <class ForwardIterator>
+	void LeftistTree<valueType , compare , skew>::push_batch(ForwardIterator first , ForwardIterator last)
+	{
+		size_t cnt = 0;
+		for (ForwardIterator it = first;it != last;++ it) ++ cnt;
+		if (!cnt) return;
+		Node **nodes = new Node *[cnt];
+		for (size_t i = 0;first != last;++ first) nodes[i ++] = new Node (*first);
+		root = merge(root , meld_all(nodes , cnt)) , tot += cnt;
+		delete [] nodes;
+	}
+
+	//extract the k largest elements: they form a subtree containing the root, so they are picked through a small frontier heap
+	//and the subtrees hanging off that subtree are melded back once instead of once per pop()
+	template <class valueType , class compare , bool skew>
+	template <class OutputIterator>
+	OutputIterator LeftistTree<valueType , compare , skew>::pop_k(size_t k , OutputIterator out)
+	{
+		if (k > size()) throw(sjtu::container_is_empty());
+		if (!k) return out;
+		Node **frontier = new Node *[k + 1];
+		size_t cnt = 1;
+		frontier[0] = root;
+		for (size_t i = 0;i < k;++ i)
+		{
+			Node *cur = frontier[0];
+			frontier[0] = frontier[-- cnt];
+			for (size_t pos = 0 , ch;(ch = (pos << 1) + 1) < cnt;pos = ch)
+			{
+				if (ch + 1 < cnt && compare()(frontier[ch] -> val , frontier[ch + 1] -> val)) ++ ch;
+				if (!compare()(frontier[pos] -> val , frontier[ch] -> val)) break;
+				std::swap(frontier[pos] , frontier[ch]);
+			}
+			Node *son[2] = {cur -> left , cur -> right};
+			for (int j = 0;j < 2;++ j) if (son[j] != nullptr)
+			{
+				size_t pos = cnt ++;
+				for (frontier[pos] = son[j];pos && compare()(frontier[pos - 1 >> 1] -> val , frontier[pos] -> val);pos = pos - 1 >> 1)
+					std::swap(frontier[pos] , frontier[pos - 1 >> 1]);
+			}
+			*out = cur -> val , ++ out , delete cur , -- tot;
+		}
+		root = meld_all(frontier , cnt);
+		delete [] frontier;
+		return out;
+	}
+
+	template <class valueType , class compare , bool skew>
+	LeftistTree<valueType , compare , skew>::~LeftistTree(){clear(root);}
+
+	template <class valueType , class compare , bool skew>
+	typename LeftistTree<valueType , compare , skew>::Node *LeftistTree<valueType , compare , skew>::merge(typename LeftistTree<valueType , compare , skew>::Node * const &lhs , typename LeftistTree<valueType , compare , skew>::Node * const &rhs)
+	{
+		return merge(lhs , rhs , LeftistRank<skew>());
+	}
+
+	template <class valueType , class compare , bool skew>
+	typename LeftistTree<valueType , compare , skew>::Node *LeftistTree<valueType , compare , skew>::merge(typename LeftistTree<valueType , compare , skew>::Node * const &lhs , typename LeftistTree<valueType , compare , skew>::Node * const &rhs , LeftistRank<false>)
+	{
+		if (lhs == nullptr) return rhs;
+		if (rhs == nullptr) return lhs;
+		Node *rt;
+		if (compare()(lhs -> val , rhs -> val)) rhs -> right = merge(lhs , rhs -> right) , rt = rhs;
+		else lhs -> right = merge(rhs , lhs -> right) , rt = lhs;
+		if (rank(rt -> left) < rank(rt -> right)) std::swap(rt -> left , rt -> right);
+		rt -> d = rank(rt -> right) + 1;
+		return rt;
+	}
+
+	//top-down skew merge: walk the right spines iteratively, swapping children on the way
+	template <class valueType , class compare , bool skew>
+	typename LeftistTree<valueType , compare , skew>::Node *LeftistTree<valueType , compare , skew>::merge(typename LeftistTree<valueType , compare , skew>::Node *lhs , typename LeftistTree<valueType , compare , skew>::Node *rhs , LeftistRank<true>)
+	{
+		if (lhs == nullptr) return rhs;
+		if (rhs == nullptr) return lhs;
+		if (compare()(lhs -> val , rhs -> val)) std::swap(lhs , rhs);
+		for (Node *cur = lhs , *nxt;;cur = nxt)
+		{
+			nxt = cur -> right , cur -> right = cur -> left;
+			if (nxt == nullptr) {cur -> left = rhs;break;}
+			if (compare()(nxt -> val , rhs -> val)) std::swap(nxt , rhs);
+			cur -> left = nxt;
+		}
+		return lhs;
+	}
+
+	//pairwise melding in rounds, O(n) merges in total for n singletons
+	template <class valueType , class compare , bool skew>
+	typename LeftistTree<valueType , compare , skew>::Node *LeftistTree<valueType , compare , skew>::meld_all(typename LeftistTree<valueType , compare , skew>::Node **nodes , size_t cnt)
+	{
+		if (!cnt) return nullptr;
+		for (;cnt > 1;cnt = cnt + 1 >> 1)
+		{
+			for (size_t i = 0;i + 1 < cnt;i += 2) nodes[i >> 1] = merge(nodes[i] , nodes[i + 1]);
+			if (cnt & 1) nodes[cnt >> 1] = nodes[cnt - 1];
+		}
+		return nodes[0];
+	}
+
+	template <class valueType , class compare , bool skew>
+	typename LeftistTree<valueType , compare , skew>::Node *LeftistTree<valueType , compare , skew>::copy(const typename LeftistTree<valueType , compare , skew>::Node * const &rt)
+	{
+		if (rt == nullptr) return nullptr;
+		Node *ret = new Node (*rt);
+		ret -> left = copy(rt -> left) , ret -> right = copy(rt -> right);
+		return ret;
+	}
+
+	template <class valueType , class compare , bool skew>
+	void LeftistTree<valueType , compare , skew>::clear(LeftistTree<valueType , compare , skew>::Node *&rt)
+	{
+		if (rt == nullptr) return;
+		clear(rt -> left) , clear(rt -> right) , delete rt , rt = nullptr;
+	}
+
+	//PairingHeap.hpp
+	template <class valueType , class compare = std::less<valueType> >
+	class PairingHeap : public PriorityQueue<valueType , compare>
+	{
+	private:
+		struct Node
+		{
+			valueType val;
+			Node *child , *sibling;
+
+			Node(const valueType &val_) : val(val_) , child(nullptr) , sibling(nullptr) {}
+		}*root;
+		size_t tot;
+
+		Node *link(Node * const & , Node * const &);
+		Node *combine(Node *);
+		Node *copy(const Node * const & , const size_t &);
+		void clear(Node *&);
+	public:
+		PairingHeap() : root(nullptr) , tot(0) {};
+		PairingHeap(const PairingHeap<valueType , compare> &);
+		PairingHeap<valueType , compare> &operator=(const PairingHeap<valueType , compare> &);
+
+		virtual bool empty() const override;
+		virtual size_t size() const override;
+
+		virtual const valueType &top() const override;
+		virtual void push(const valueType &) override;
+		virtual void pop() override;
+
+		void join(PairingHeap<valueType , compare> &);
+
+		template <class ForwardIterator> void push_batch(ForwardIterator , ForwardIterator);
+		template <class OutputIterator> OutputIterator pop_k(size_t , OutputIterator);
+
+		virtual ~PairingHeap();
+	};
+
 	template <class valueType , class compare>
-	LeftistTree<valueType , compare>::LeftistTree(const LeftistTree<valueType , compare> &rhs){root = copy(rhs.root);}
+	PairingHeap<valueType , compare>::PairingHeap(const PairingHeap<valueType , compare> &rhs){root = copy(rhs.root , rhs.tot) , tot = rhs.tot;}
 
 	template <class valueType , class compare>
-	LeftistTree<valueType , compare> &LeftistTree<valueType , compare>::operator=(const LeftistTree<valueType , compare> &rhs)
+	PairingHeap<valueType , compare> &PairingHeap<valueType , compare>::operator=(const PairingHeap<valueType , compare> &rhs)
 	{
 		if (this == &rhs) return *this;
-		clear(root) , root = copy(rhs.root);
+		clear(root) , root = copy(rhs.root , rhs.tot) , tot = rhs.tot;
 		return *this;
 	}
 
 	template <class valueType , class compare>
-	bool LeftistTree<valueType , compare>::empty() const {return root == nullptr;}
+	bool PairingHeap<valueType , compare>::empty() const {return root == nullptr;}
 
 	template <class valueType , class compare>
-	size_t LeftistTree<valueType , compare>::size() const {return empty() ? 0 : root -> tot;}
+	size_t PairingHeap<valueType , compare>::size() const {return tot;}
 
 	template <class valueType , class compare>
-	const valueType &LeftistTree<valueType , compare>::top() const
+	const valueType &PairingHeap<valueType , compare>::top() const
 	{
 		if (empty()) throw(sjtu::container_is_empty());
 		return root -> val;
 	}
 
 	template <class valueType , class compare>
-	void LeftistTree<valueType , compare>::push(const valueType &val)
+	void PairingHeap<valueType , compare>::push(const valueType &val){root = link(root , new Node (val)) , ++ tot;}
+
+	template <class valueType , class compare>
+	void PairingHeap<valueType , compare>::pop()
 	{
-		LeftistTree<valueType , compare> tmp(new Node (val));
-		tmp.root -> tot = 1 , tmp.root -> d = 0 , tmp.root -> left = tmp.root -> right = nullptr;
-		join(tmp);
+		if (empty()) throw(sjtu::container_is_empty());
+		Node *rt = root;
+		root = combine(rt -> child) , delete rt , -- tot;
 	}
 
 	template <class valueType , class compare>
-	void LeftistTree<valueType , compare>::pop()
+	void PairingHeap<valueType , compare>::join(PairingHeap<valueType , compare> &rhs)
 	{
-		if (empty()) throw(sjtu::container_is_empty());
-		LeftistTree<valueType , compare> lst(root -> left) , rst(root -> right);
-		delete root , lst.join(rst) , root = lst.root , lst.root = nullptr;
+		if (this == &rhs) return;
+		root = link(root , rhs.root) , tot += rhs.tot , rhs.root = nullptr , rhs.tot = 0;
+	}
+
+	template <class valueType , class compare>
+	template <class ForwardIterator>
+	void PairingHeap<valueType , compare>::push_batch(ForwardIterator first , ForwardIterator last)
+	{
+		for (;first != last;++ first) push(*first);
 	}
 
 	template <class valueType , class compare>
-	void LeftistTree<valueType , compare>::join(LeftistTree<valueType , compare> &rhs){root = merge(root , rhs.root) , rhs.root = nullptr;}
+	template <class OutputIterator>
+	OutputIterator PairingHeap<valueType , compare>::pop_k(size_t k , OutputIterator out)
+	{
+		if (k > size()) throw(sjtu::container_is_empty());
+		for (;k;-- k) *out = root -> val , ++ out , pop();
+		return out;
+	}
 
 	template <class valueType , class compare>
-	LeftistTree<valueType , compare>::~LeftistTree(){clear(root);}
+	PairingHeap<valueType , compare>::~PairingHeap(){clear(root);}
 
+	//lhs and rhs are roots (their sibling pointers are unused)
 	template <class valueType , class compare>
-	typename LeftistTree<valueType , compare>::Node *LeftistTree<valueType , compare>::merge(typename LeftistTree<valueType , compare>::Node * const &lhs , typename LeftistTree<valueType , compare>::Node * const &rhs)
+	typename PairingHeap<valueType , compare>::Node *PairingHeap<valueType , compare>::link(typename PairingHeap<valueType , compare>::Node * const &lhs , typename PairingHeap<valueType , compare>::Node * const &rhs)
 	{
 		if (lhs == nullptr) return rhs;
 		if (rhs == nullptr) return lhs;
-		Node *rt;
-		if (compare()(lhs -> val , rhs -> val)) rhs -> right = merge(lhs , rhs -> right) , rt = rhs;
-		else lhs -> right = merge(rhs , lhs -> right) , rt = lhs;
-		rt -> tot = (rt -> left == nullptr ? 0 : rt -> left -> tot) + (rt -> right == nullptr ? 0 : rt -> right -> tot) + 1;
-		if ((int)(rt -> left == nullptr ? -1 : rt -> left -> d) < (int)(rt -> right == nullptr ? -1 : rt -> right -> d)) std::swap(rt -> left , rt -> right);
-		rt -> d = (rt -> right == nullptr ? -1 : rt -> right -> d) + 1;
-		return rt;
+		if (compare()(lhs -> val , rhs -> val)) {lhs -> sibling = rhs -> child , rhs -> child = lhs;return rhs;}
+		rhs -> sibling = lhs -> child , lhs -> child = rhs;
+		return lhs;
+	}
+
+	//two-pass pairing: link neighbours left to right (stacking the results through sibling), then fold right to left
+	template <class valueType , class compare>
+	typename PairingHeap<valueType , compare>::Node *PairingHeap<valueType , compare>::combine(typename PairingHeap<valueType , compare>::Node *list)
+	{
+		Node *paired = nullptr;
+		for (Node *a , *b;list != nullptr;)
+		{
+			a = list , b = list -> sibling;
+			if (b == nullptr) list = nullptr , a -> sibling = nullptr;
+			else list = b -> sibling , a -> sibling = b -> sibling = nullptr , a = link(a , b);
+			a -> sibling = paired , paired = a;
+		}
+		Node *ret = nullptr;
+		for (Node *nxt;paired != nullptr;paired = nxt) nxt = paired -> sibling , paired -> sibling = nullptr , ret = link(ret , paired);
+		return ret;
 	}
 
+	//iterative so that long child or sibling chains cannot exhaust the stack
 	template <class valueType , class compare>
-	typename LeftistTree<valueType , compare>::Node *LeftistTree<valueType , compare>::copy(const typename LeftistTree<valueType , compare>::Node * const &rt)
+	typename PairingHeap<valueType , compare>::Node *PairingHeap<valueType , compare>::copy(const typename PairingHeap<valueType , compare>::Node * const &rt , const size_t &cnt)
 	{
 		if (rt == nullptr) return nullptr;
-		Node *ret = new Node (rt -> val);
-		ret -> tot = rt -> tot , ret -> d = rt -> d;
-		ret -> left = copy(rt -> left) , ret -> right = copy(rt -> right);
+		Node *ret;
+		const Node **src = new const Node *[cnt];
+		Node ***dst = new Node **[cnt];
+		size_t top = 0;
+		for (src[top] = rt , dst[top ++] = &ret;top;)
+		{
+			const Node *node = src[-- top];
+			Node **slot = dst[top];
+			*slot = new Node (node -> val);
+			if (node -> child) src[top] = node -> child , dst[top ++] = &((*slot) -> child);
+			if (node -> sibling) src[top] = node -> sibling , dst[top ++] = &((*slot) -> sibling);
+		}
+		delete [] src , delete [] dst;
 		return ret;
 	}
 
 	template <class valueType , class compare>
-	void LeftistTree<valueType , compare>::clear(LeftistTree<valueType , compare>::Node *&rt)
+	void PairingHeap<valueType , compare>::clear(typename PairingHeap<valueType , compare>::Node *&rt)
 	{
-		if (rt == nullptr) return;
-		clear(rt -> left) , clear(rt -> right) , delete rt , rt = nullptr;
+		for (Node *nxt;rt != nullptr;rt = nxt)
+		{
+			if (rt -> child != nullptr)
+			{
+				Node *last = rt -> child;
+				for (;last -> sibling != nullptr;last = last -> sibling);
+				last -> sibling = rt -> sibling , rt -> sibling = rt -> child;
+			}
+			nxt = rt -> sibling , delete rt;
+		}
 	}
+
+	//KeyedCompare.hpp
+	//a value together with a cheap key precomputed by keyOf; keyOf must be monotone with compare,
+	//i.e. compare()(a , b) implies keyOf()(a) <= keyOf()(b)
+	template <class valueType , class keyOf>
+	struct KeyedValue
+	{
+		typedef decltype(keyOf()(std::declval<const valueType &>())) keyType;
+
+		keyType key;
+		valueType val;
+
+		KeyedValue(const valueType &val_) : key(keyOf()(val_)) , val(val_) {}
+	};
+
+	//orders KeyedValues by key, falling back to compare on the full values only when keys tie
+	template <class valueType , class keyOf , class compare = std::less<valueType> >
+	struct KeyedCompare
+	{
+		bool operator()(const KeyedValue<valueType , keyOf> &lhs , const KeyedValue<valueType , keyOf> &rhs) const
+		{
+			if (lhs.key < rhs.key) return true;
+			if (rhs.key < lhs.key) return false;
+			return compare()(lhs.val , rhs.val);
+		}
+	};
+
+	//CountingCompare.hpp
+	//forwards to compare and counts the invocations, shared by every instance with the same parameters
+	template <class valueType , class compare = std::less<valueType> >
+	struct CountingCompare
+	{
+		static size_t calls;
+
+		bool operator()(const valueType &lhs , const valueType &rhs) const {return ++ calls , compare()(lhs , rhs);}
+	};
+
+	template <class valueType , class compare>
+	size_t CountingCompare<valueType , compare>::calls = 0;
 };
 
 namespace sjtu {
 
 /**
  * a container like std::priority_queue which is a heap internal.
+ * Heap selects the backend: dslib::LeftistTree (default, optionally in skew mode)
+ * or dslib::PairingHeap, which has O(1) push and merge.
  */
-template<typename T, class Compare = std::less<T>>
+template<typename T, class Compare = std::less<T>, class Heap = dslib::LeftistTree<T, Compare>>
 class priority_queue {
 private:
-	dslib::LeftistTree<T , Compare> p_queue;
+	Heap p_queue;
 public:
 	/**
 	 * TODO constructors
@@ -205,6 +513,109 @@ public:
 	void merge(priority_queue &other) {
 		p_queue.join(other.p_queue);
 	}
+	/**
+	 * push every element of [first, last) at once.
+	 * the batch is built into a heap in linear time and melded in with a single merge.
+	 */
+	template <class ForwardIterator>
+	void push_batch(ForwardIterator first, ForwardIterator last) {
+		p_queue.push_batch(first, last);
+	}
+	/**
+	 * pop the k top elements in order, writing them to out.
+	 * @return the output iterator past the last written element.
+	 * throw container_is_empty if size() < k, in which case nothing is popped.
+	 */
+	template <class OutputIterator>
+	OutputIterator pop_k(size_t k, OutputIterator out) {
+		return p_queue.pop_k(k, out);
+	}
+};
+
+/**
+ * a priority_queue for values with an expensive Compare.
+ * every element stores KeyOf()(value), a cheap key (e.g. a 64-bit prefix or score) that must be
+ * monotone with Compare; elements are ordered by key and Compare only runs when keys tie.
+ */
+template<typename T, class KeyOf, class Compare = std::less<T>,
+	class Heap = dslib::LeftistTree<dslib::KeyedValue<T, KeyOf>, dslib::KeyedCompare<T, KeyOf, Compare>>>
+class keyed_priority_queue {
+private:
+	typedef dslib::KeyedValue<T, KeyOf> value_type;
+
+	Heap p_queue;
+
+	template <class Iterator>
+	class key_iterator {
+	private:
+		Iterator it;
+	public:
+		key_iterator(const Iterator &it_) : it(it_) {}
+		value_type operator*() const {return value_type(*it);}
+		key_iterator &operator++() {++it;return *this;}
+		bool operator!=(const key_iterator &rhs) const {return it != rhs.it;}
+	};
+
+	template <class OutputIterator>
+	class value_output {
+	private:
+		OutputIterator &out;
+	public:
+		value_output(OutputIterator &out_) : out(out_) {}
+		value_output &operator*() {return *this;}
+		value_output &operator=(const value_type &rhs) {*out = rhs.val;return *this;}
+		value_output &operator++() {++out;return *this;}
+	};
+public:
+	keyed_priority_queue() {}
+	keyed_priority_queue(const keyed_priority_queue &other) : p_queue(other.p_queue) {}
+	~keyed_priority_queue() {}
+	keyed_priority_queue &operator=(const keyed_priority_queue &other)
+	{
+		p_queue = other.p_queue;
+		return *this;
+	}
+	/**
+	 * get the top of the queue.
+	 * throw container_is_empty if empty() returns true;
+	 */
+	const T & top() const {
+		return p_queue.top().val;
+	}
+	/**
+	 * push new element to the priority queue, computing its key once.
+	 */
+	void push(const T &e) {
+		p_queue.push(value_type(e));
+	}
+	/**
+	 * delete the top element.
+	 * throw container_is_empty if empty() returns true;
+	 */
+	void pop() {
+		p_queue.pop();
+	}
+	size_t size() const {
+		return p_queue.size();
+	}
+	bool empty() const {
+		return p_queue.empty();
+	}
+	void merge(keyed_priority_queue &other) {
+		p_queue.join(other.p_queue);
+	}
+	template <class ForwardIterator>
+	void push_batch(ForwardIterator first, ForwardIterator last) {
+		p_queue.push_batch(key_iterator<ForwardIterator>(first), key_iterator<ForwardIterator>(last));
+	}
+	/**
+	 * same as priority_queue::pop_k.
+	 */
+	template <class OutputIterator>
+	OutputIterator pop_k(size_t k, OutputIterator out) {
+		p_queue.pop_k(k, value_output<OutputIterator>(out));
+		return out;
+	}
 };
 
 }
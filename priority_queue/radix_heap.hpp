@@ -0,0 +1,151 @@
+#ifndef SJTU_RADIX_HEAP_HPP
+#define SJTU_RADIX_HEAP_HPP
+#include <cstddef>
+#include "exceptions.hpp"
+#include "utility.hpp"
+
+namespace sjtu {
+
+/**
+ * a monotone min-heap for unsigned integer keys (e.g. Dijkstra distances).
+ * keys pushed must not be smaller than the last popped key.
+ * elements live in sizeof(Key) * 8 + 1 buckets, bucket i holding keys whose highest bit
+ * differing from the last extracted key is bit i - 1, so no key comparisons are made
+ * and every element moves down at most O(log C) times.
+ */
+template<typename Key, typename Value>
+class radix_heap {
+private:
+	static const size_t bits = sizeof(Key) * 8;
+
+	struct Node
+	{
+		pair<Key , Value> val;
+		Node *succ;
+
+		Node(const Key &key , const Value &value , Node * const &succ_) : val(key , value) , succ(succ_) {}
+	};
+
+	Node *bucket[bits + 1];
+	Key last;
+	size_t tot;
+	mutable Node *cache;
+	mutable size_t cache_bucket;
+
+	//index of the highest set bit of key ^ last plus one, 0 if key == last
+	size_t bucket_of(const Key &key) const
+	{
+		Key x = key ^ last;
+		size_t ret = 0;
+		for (size_t w = bits >> 1;w;w >>= 1)
+			if (x >> w) x >>= w , ret += w;
+		return ret + (x ? 1 : 0);
+	}
+
+	//first non-empty bucket and its smallest element
+	Node *find_min(size_t &i) const
+	{
+		for (i = 0;bucket[i] == nullptr;++ i);
+		Node *ret = bucket[i];
+		if (i) for (Node *cur = ret -> succ;cur;cur = cur -> succ)
+			if (cur -> val.first < ret -> val.first) ret = cur;
+		return ret;
+	}
+
+	//unlinks node from bucket[i], redistributing the rest of the bucket around node's key if i > 0
+	void extract(Node *node , size_t i)
+	{
+		if (!i)
+		{
+			Node **cur = &bucket[0];
+			for (;*cur != node;cur = &((*cur) -> succ));
+			*cur = node -> succ;
+			return;
+		}
+		Node *rest = bucket[i];
+		last = node -> val.first , bucket[i] = nullptr;
+		for (Node *nxt;rest;rest = nxt)
+		{
+			nxt = rest -> succ;
+			if (rest == node) continue;
+			size_t j = bucket_of(rest -> val.first);
+			rest -> succ = bucket[j] , bucket[j] = rest;
+		}
+	}
+
+	void copy(const radix_heap &other)
+	{
+		for (size_t i = 0;i <= bits;++ i)
+		{
+			bucket[i] = nullptr;
+			for (Node *node = other.bucket[i] , **tail = &bucket[i];node;node = node -> succ , tail = &((*tail) -> succ))
+				*tail = new Node (node -> val.first , node -> val.second , nullptr);
+		}
+		last = other.last , tot = other.tot , cache = nullptr;
+	}
+
+	void clear()
+	{
+		for (size_t i = 0;i <= bits;++ i)
+			for (Node *nxt;bucket[i];bucket[i] = nxt) nxt = bucket[i] -> succ , delete bucket[i];
+		tot = 0 , cache = nullptr;
+	}
+public:
+	radix_heap() : last(0) , tot(0) , cache(nullptr)
+	{
+		for (size_t i = 0;i <= bits;++ i) bucket[i] = nullptr;
+	}
+	radix_heap(const radix_heap &other) {copy(other);}
+	~radix_heap() {clear();}
+	radix_heap &operator=(const radix_heap &other)
+	{
+		if (this == &other) return *this;
+		clear() , copy(other);
+		return *this;
+	}
+	/**
+	 * get the element with the smallest key.
+	 * throw container_is_empty if empty() returns true;
+	 */
+	const pair<Key, Value> & top() const {
+		if (!tot) throw(container_is_empty());
+		if (cache == nullptr) cache = find_min(cache_bucket);
+		return cache -> val;
+	}
+	/**
+	 * push new element to the heap.
+	 * throw runtime_error if key is smaller than the last popped key.
+	 */
+	void push(const Key &key, const Value &value) {
+		if (key < last) throw(runtime_error());
+		size_t i = bucket_of(key);
+		bucket[i] = new Node (key , value , bucket[i]) , ++ tot;
+		if (cache != nullptr && key < cache -> val.first) cache = bucket[i] , cache_bucket = i;
+	}
+	/**
+	 * delete the top element.
+	 * throw container_is_empty if empty() returns true;
+	 */
+	void pop() {
+		if (!tot) throw(container_is_empty());
+		if (cache == nullptr) cache = find_min(cache_bucket);
+		extract(cache , cache_bucket);
+		delete cache , -- tot , cache = nullptr;
+	}
+	/**
+	 * return the number of the elements.
+	 */
+	size_t size() const {
+		return tot;
+	}
+	/**
+	 * check if the container has at least an element.
+	 */
+	bool empty() const {
+		return !tot;
+	}
+};
+
+}
+
+#endif
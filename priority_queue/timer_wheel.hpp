@@ -0,0 +1,194 @@
+#ifndef SJTU_TIMER_WHEEL_HPP
+#define SJTU_TIMER_WHEEL_HPP
+#include <cstddef>
+#include "exceptions.hpp"
+#include "utility.hpp"
+#include "priority_queue.hpp"
+
+namespace sjtu {
+
+/**
+ * a hierarchical timer wheel for events keyed by integer timestamps.
+ * four levels of 256 slots cover the next 2^32 ticks; a slot on level l holds the events
+ * that agree with the current time on every bit above 8 * (l + 1). events further out wait
+ * in a priority_queue and are pulled in when the wheel reaches their 2^32 block.
+ * schedule and cancel are O(1), advance is amortized O(1) per event and per non-empty tick.
+ */
+template<typename T>
+class timer_wheel {
+public:
+	typedef unsigned long long time_type;
+private:
+	static const int bits = 8 , levels = 4 , slots = 1 << bits;
+	static const int overflow = levels , due = levels + 1 , cancelled = levels + 2;
+
+	struct Link
+	{
+		Link *prec , *succ;
+
+		Link() : prec(this) , succ(this) {}
+	};
+
+	struct Node : Link
+	{
+		time_type when;
+		T value;
+		int level;
+
+		Node(const time_type &when_ , const T &value_) : when(when_) , value(value_) , level(0) {}
+	};
+
+	struct LaterFirst
+	{
+		bool operator()(const Node * const &lhs , const Node * const &rhs) const {return rhs -> when < lhs -> when;}
+	};
+
+	Link wheel[levels][slots] , ready;
+	size_t count[levels + 2];
+	priority_queue<Node * , LaterFirst> far;
+	time_type cur;
+	size_t tot;
+
+	static void unlink(Link *link) {link -> prec -> succ = link -> succ , link -> succ -> prec = link -> prec;}
+
+	static void link_before(Link *pos , Link *link) {link -> prec = pos -> prec , link -> succ = pos , pos -> prec -> succ = link , pos -> prec = link;}
+
+	void place(Node *node)
+	{
+		int level = 0;
+		for (;level < levels && (node -> when >> bits * (level + 1)) != (cur >> bits * (level + 1));++ level);
+		if (node -> when <= cur) level = due;
+		node -> level = level , ++ count[level];
+		if (level == due) link_before(&ready , node);
+		else if (level == overflow) far.push(node);
+		else link_before(&wheel[level][node -> when >> bits * level & slots - 1] , node);
+	}
+
+	//re-places every event of a slot, all of which now fall on lower levels (or are due)
+	void cascade(Link &slot , int level)
+	{
+		for (Link *link = slot.succ , *nxt;link != &slot;link = nxt)
+			nxt = link -> succ , -- count[level] , place(static_cast<Node *>(link));
+		slot.prec = slot.succ = &slot;
+	}
+
+	void pull_far()
+	{
+		for (;!far.empty() && (far.top() -> when >> bits * levels) <= (cur >> bits * levels);)
+		{
+			Node *node = far.top();
+			far.pop();
+			if (node -> level == cancelled) delete node;
+			else -- count[overflow] , place(node);
+		}
+	}
+
+	//steps to cur + 1, cascading the slots whose block begins there
+	void tick()
+	{
+		++ cur;
+		int top = 0;
+		for (;top < levels && !(cur >> bits * top & slots - 1);++ top);
+		if (top == levels) pull_far() , top = levels - 1;
+		for (int level = top;level > 0;-- level) cascade(wheel[level][cur >> bits * level & slots - 1] , level);
+		cascade(wheel[0][cur & slots - 1] , 0);
+	}
+
+	void clear(Link &list)
+	{
+		for (Link *link = list.succ , *nxt;link != &list;link = nxt) nxt = link -> succ , delete static_cast<Node *>(link);
+		list.prec = list.succ = &list;
+	}
+public:
+	/**
+	 * a handle to a scheduled event, valid until the event is popped or cancelled.
+	 */
+	class timer {
+		friend class timer_wheel;
+	private:
+		Node *node;
+		explicit timer(Node *node_) : node(node_) {}
+	public:
+		timer() : node(nullptr) {}
+		time_type when() const {return node -> when;}
+	};
+
+	explicit timer_wheel(const time_type &start = 0) : cur(start) , tot(0)
+	{
+		for (int i = 0;i < levels + 2;++ i) count[i] = 0;
+	}
+	timer_wheel(const timer_wheel &) = delete;
+	timer_wheel &operator=(const timer_wheel &) = delete;
+	~timer_wheel()
+	{
+		for (int level = 0;level < levels;++ level)
+			for (int i = 0;i < slots;++ i) clear(wheel[level][i]);
+		clear(ready);
+		for (;!far.empty();far.pop()) delete far.top();
+	}
+	/**
+	 * schedule value at time when; if when is not after now(), it is due at once.
+	 */
+	timer schedule(const time_type &when, const T &value) {
+		Node *node = new Node (when , value);
+		place(node) , ++ tot;
+		return timer(node);
+	}
+	/**
+	 * cancel a pending event. events beyond the wheel are only marked, and freed once the wheel reaches
+	 * their block or the wheel is destroyed.
+	 * throw invalid_iterator if the handle is empty.
+	 */
+	void cancel(timer &t) {
+		if (t.node == nullptr) throw(invalid_iterator());
+		Node *node = t.node;
+		-- count[node -> level] , -- tot , t.node = nullptr;
+		if (node -> level == overflow) node -> level = cancelled;
+		else unlink(node) , delete node;
+	}
+	/**
+	 * move the current time forward to t, making every event with when <= t due.
+	 * empty stretches of the wheel are skipped a block at a time.
+	 */
+	void advance(const time_type &t) {
+		while (cur < t)
+		{
+			int empty = 0;
+			for (;empty < levels && !count[empty];++ empty);
+			if (empty)
+			{
+				if (empty == levels && !count[overflow]) {cur = t;break;}
+				time_type boundary = cur | (empty == levels ? ~0ull >> 64 - bits * levels : (1ull << bits * empty) - 1);
+				if (boundary >= t) {cur = t;break;}
+				cur = boundary;
+			}
+			tick();
+		}
+	}
+	/**
+	 * write the values of all due events to out, in the order they fell due, and forget them.
+	 * @return the output iterator past the last written value.
+	 */
+	template <class OutputIterator>
+	OutputIterator pop_due(OutputIterator out) {
+		for (Link *link = ready.succ , *nxt;link != &ready;link = nxt)
+		{
+			nxt = link -> succ;
+			*out = static_cast<Node *>(link) -> value , ++ out;
+			delete static_cast<Node *>(link);
+		}
+		ready.prec = ready.succ = &ready , tot -= count[due] , count[due] = 0;
+		return out;
+	}
+	time_type now() const {return cur;}
+	/**
+	 * the number of pending events, due or not.
+	 */
+	size_t size() const {return tot;}
+	size_t due_count() const {return count[due];}
+	bool empty() const {return !tot;}
+};
+
+}
+
+#endif